@@ -74,7 +74,7 @@ void UEnhancedPaletteCategory::NativeInitialize()
 {
 }
 
-void UEnhancedPaletteCategory::Tick(float DeltaTime)
+bool UEnhancedPaletteCategory::Tick(float DeltaTime)
 {
 	if (bTickable)
 	{
@@ -86,17 +86,20 @@ void UEnhancedPaletteCategory::Tick(float DeltaTime)
 			FEditorScriptExecutionGuard Guard;
 			NativeTick();
 			K2_Tick();
+			return true;
 		}
 	}
+	return false;
 }
 
 void UEnhancedPaletteCategory::NativeTick()
 {
 }
 
-void UEnhancedPaletteCategory::GatherItems(TArray<TConfigPlaceableItem>& OutResult)
+void UEnhancedPaletteCategory::GatherItems(TArray<TConfigPlaceableItem>& OutResult, const FPaletteGatherToken& InToken)
 {
 	TGuardValue<bool> IsGathering(bGathering, true);
+	TGuardValue<FPaletteGatherToken> Token(GatherToken, InToken);
 
 	// reset all previousy registered elements and state
 	AutoOrder.Reset();
@@ -105,13 +108,30 @@ void UEnhancedPaletteCategory::GatherItems(TArray<TConfigPlaceableItem>& OutResu
 	{
 		FEditorScriptExecutionGuard Guard;
 		NativeGatherItems();
-		K2_GatherItems();
+		if (!IsGatherCancelled())
+		{
+			K2_GatherItems();
+		}
 	}
 
-	OutResult = MoveTemp(LocalDescriptors);
+	if (IsGatherCancelled())
+	{
+		// partial results of superseded gather are never used
+		UE_LOG(LogEnhancedPalette, Verbose, TEXT("Gather of %s cancelled"), *GetName());
+		OutResult.Reset();
+	}
+	else
+	{
+		OutResult = MoveTemp(LocalDescriptors);
+	}
 	LocalDescriptors.Reset();
 }
 
+bool UEnhancedPaletteCategory::IsGatherCancelled() const
+{
+	return bGathering && GatherToken.IsCancelled();
+}
+
 void UEnhancedPaletteCategory::NativeGatherItems()
 {
 }
@@ -153,7 +173,7 @@ void UEnhancedPaletteCategory::PostItemAdded(TConfigPlaceableItem& Item)
 
 void UEnhancedPaletteCategory::AddInternal(const TConfigPlaceableItem& Item)
 {
-	if (CanAddItem(Item))
+	if (!IsGatherCancelled() && CanAddItem(Item))
 	{
 		PostItemAdded(LocalDescriptors.Emplace_GetRef(Item));
 	}
@@ -161,7 +181,7 @@ void UEnhancedPaletteCategory::AddInternal(const TConfigPlaceableItem& Item)
 
 void UEnhancedPaletteCategory::AddInternal(TConfigPlaceableItem&& Item)
 {
-	if (CanAddItem(Item))
+	if (!IsGatherCancelled() && CanAddItem(Item))
 	{
 		PostItemAdded(LocalDescriptors.Emplace_GetRef(MoveTemp(Item)));
 	}
@@ -4,7 +4,11 @@
 #include "EnhancedPaletteGlobals.h"
 #include "EnhancedPaletteSubsystem.h"
 #include "EnhancedPaletteCategory.h"
-#include "IconReferenceCustomization.h"
+#include "EnhancedPalettePopulateAction.h"
+#include "IconCatalog.h"
+#include "PaletteWorldIndex.h"
+#include "PaletteTagIndex.h"
+#include "AssetRegistry/IAssetRegistry.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(EnhancedPaletteLibrary)
 
@@ -24,6 +28,23 @@ void UEnhancedPaletteLibrary::RequestPopulateCategories()
 	}
 }
 
+UEnhancedPalettePopulateAction* UEnhancedPaletteLibrary::StartPopulateCategories(const TArray<FName>& Categories, bool bDiscover, float TimeoutSeconds)
+{
+	UEnhancedPalettePopulateAction* Action = UEnhancedPalettePopulateAction::WaitForPopulate(Categories, bDiscover, TimeoutSeconds);
+	Action->Activate();
+	return Action;
+}
+
+TArray<FPaletteSearchResult> UEnhancedPaletteLibrary::SearchPlaceableItems(const FString& Query, int32 MaxResults)
+{
+	TArray<FPaletteSearchResult> Results;
+	if (auto* Subsystem = UEnhancedPaletteSubsystem::Get())
+	{
+		Subsystem->SearchPlaceableItems(Query, MaxResults, Results);
+	}
+	return Results;
+}
+
 bool UEnhancedPaletteLibrary::RegisterExternalCategory(FName UniqueId, FText DisplayName, FText ShortDisplayName, FString DisplayIconCode, int32 SortOrder, bool bSortable)
 {
 	if (UniqueId.IsNone())
@@ -55,18 +76,18 @@ bool UEnhancedPaletteLibrary::RegisterExternalCategory(FName UniqueId, FText Dis
 	return false;
 }
 
-TArray<FString> UEnhancedPaletteLibrary::K2_IconSelectorHelper()
+int32 UEnhancedPaletteLibrary::RegisterExternalCategories(const TArray<FStaticPlacementCategoryInfo>& Categories)
 {
-	static TArray<FString> LocalStorage;
-	if (!LocalStorage.Num())
+	if (auto* Subsystem = UEnhancedPaletteSubsystem::Get())
 	{
-		FSimpleIconReferenceCustomization::GatherIcons([&](FName StyleSet, FName IconName)
-		{
-			LocalStorage.Add(FSimpleIconReference(StyleSet, IconName).GetIconCode());
-		});
-		Algo::Sort(LocalStorage);
+		return Subsystem->CreateExternalCategories(Categories);
 	}
-	return LocalStorage;
+	return 0;
+}
+
+TArray<FString> UEnhancedPaletteLibrary::K2_IconSelectorHelper()
+{
+	return FIconCatalog::Get()->GetIconCodes();
 }
 
 bool UEnhancedPaletteLibrary::UnregisterExternalCategory(FName UniqueId)
@@ -88,6 +109,25 @@ bool UEnhancedPaletteLibrary::AddCategoryPlaceableItem(FName UniqueId, TInstance
 	return true;
 }
 
+TArray<FGuid> UEnhancedPaletteLibrary::AddCategoryPlaceableItems(FName UniqueId, const TArray<TInstancedStruct<FConfigPlaceableItem>>& Descriptors)
+{
+	TArray<FGuid> Handles;
+	if (auto* Subsystem = UEnhancedPaletteSubsystem::Get())
+	{
+		Subsystem->AddExternalCategoryItems(UniqueId, Descriptors, Handles);
+	}
+	return Handles;
+}
+
+int32 UEnhancedPaletteLibrary::RemoveCategoryPlaceableItems(FName UniqueId, const TArray<FGuid>& Handles)
+{
+	if (auto* Subsystem = UEnhancedPaletteSubsystem::Get())
+	{
+		return Subsystem->RemoveExternalCategoryItems(UniqueId, Handles);
+	}
+	return 0;
+}
+
 void UEnhancedPaletteLibrary::NotifyCategoryChanged(UEnhancedPaletteCategory* Category, bool bContent, bool bInfo)
 {
 	auto* Subsystem = UEnhancedPaletteSubsystem::Get();
@@ -104,6 +144,103 @@ void UEnhancedPaletteLibrary::NotifyCategoryChanged(UEnhancedPaletteCategory* Ca
 	}
 }
 
+TArray<AActor*> UEnhancedPaletteLibrary::GetLevelActorsOfClass(TSubclassOf<AActor> Class, bool bIncludeSubclasses)
+{
+	TArray<AActor*> Result;
+	if (auto* Subsystem = UEnhancedPaletteSubsystem::Get())
+	{
+		Subsystem->GetWorldIndex().FindActorsOfClass(Class.Get() ? Class.Get() : AActor::StaticClass(), bIncludeSubclasses, Result);
+	}
+	return Result;
+}
+
+TArray<AActor*> UEnhancedPaletteLibrary::GetLevelActorsWithTag(FName Tag)
+{
+	TArray<AActor*> Result;
+	if (auto* Subsystem = UEnhancedPaletteSubsystem::Get())
+	{
+		Subsystem->GetWorldIndex().FindActorsWithTag(Tag, Result);
+	}
+	return Result;
+}
+
+TArray<AActor*> UEnhancedPaletteLibrary::GetLevelActorsInFolder(FName Folder, bool bIncludeSubfolders)
+{
+	TArray<AActor*> Result;
+	if (auto* Subsystem = UEnhancedPaletteSubsystem::Get())
+	{
+		Subsystem->GetWorldIndex().FindActorsInFolder(Folder, bIncludeSubfolders, Result);
+	}
+	return Result;
+}
+
+int32 UEnhancedPaletteLibrary::GetLevelActorClassUsage(TSubclassOf<AActor> Class, bool bIncludeSubclasses)
+{
+	if (auto* Subsystem = UEnhancedPaletteSubsystem::Get())
+	{
+		return Subsystem->GetWorldIndex().GetClassUsageCount(Class.Get() ? Class.Get() : AActor::StaticClass(), bIncludeSubclasses);
+	}
+	return 0;
+}
+
+TArray<FPaletteClassUsage> UEnhancedPaletteLibrary::GetMostUsedLevelActorClasses(int32 MaxResults)
+{
+	TArray<FPaletteClassUsage> Result;
+	if (auto* Subsystem = UEnhancedPaletteSubsystem::Get())
+	{
+		TArray<TPair<UClass*, int32>> Classes;
+		Subsystem->GetWorldIndex().GetMostUsedClasses(MaxResults, Classes);
+
+		Result.Reserve(Classes.Num());
+		for (const TPair<UClass*, int32>& Pair : Classes)
+		{
+			FPaletteClassUsage& Usage = Result.AddDefaulted_GetRef();
+			Usage.Class = Pair.Key;
+			Usage.Count = Pair.Value;
+		}
+	}
+	return Result;
+}
+
+TArray<FAssetData> UEnhancedPaletteLibrary::GetAssetsByTagValue(FName Tag, const FString& Value)
+{
+	TArray<FAssetData> Result;
+	if (auto* Subsystem = UEnhancedPaletteSubsystem::Get())
+	{
+		TArray<FSoftObjectPath> Paths;
+		if (!Subsystem->GetTagIndex().FindAssets(Tag, Value, Paths))
+		{
+			UE_LOG(LogEnhancedPalette, Warning, TEXT("Tag %s is not indexed, declare it in IndexedAssetTags of a category"), *Tag.ToString());
+			return Result;
+		}
+
+		IAssetRegistry& Registry = IAssetRegistry::GetChecked();
+		Result.Reserve(Paths.Num());
+		for (const FSoftObjectPath& Path : Paths)
+		{
+			FAssetData Asset = Registry.GetAssetByObjectPath(Path, true);
+			if (Asset.IsValid())
+			{
+				Result.Add(MoveTemp(Asset));
+			}
+		}
+	}
+	return Result;
+}
+
+TArray<FString> UEnhancedPaletteLibrary::GetIndexedTagValues(FName Tag)
+{
+	TArray<FString> Result;
+	if (auto* Subsystem = UEnhancedPaletteSubsystem::Get())
+	{
+		if (!Subsystem->GetTagIndex().GetValues(Tag, Result))
+		{
+			UE_LOG(LogEnhancedPalette, Warning, TEXT("Tag %s is not indexed, declare it in IndexedAssetTags of a category"), *Tag.ToString());
+		}
+	}
+	return Result;
+}
+
 UActorFactory* UEnhancedPaletteLibrary::FindActorFactory(TSubclassOf<UActorFactory> Class)
 {
 	return GEditor->FindActorFactoryByClass(Class);
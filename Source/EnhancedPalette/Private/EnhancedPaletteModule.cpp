@@ -7,12 +7,15 @@
 #include "BlueprintEditorSettings.h"
 #include "EnhancedPaletteCategory.h"
 #include "IconReferenceCustomization.h"
+#include "IconCatalog.h"
 #include "Kismet2/KismetEditorUtilities.h"
 
 #define LOCTEXT_NAMESPACE "EnhancedPalette"
 
 DEFINE_LOG_CATEGORY(LogEnhancedPalette);
 
+UE_TRACE_CHANNEL_DEFINE(EnhancedPaletteChannel);
+
 IMPLEMENT_MODULE(FEnhancedPaletteModule, EnhancedPalette);
 
 void FEnhancedPaletteModule::StartupModule()
@@ -49,6 +52,8 @@ void FEnhancedPaletteModule::ShutdownModule()
 	FKismetEditorUtilities::UnregisterAutoBlueprintNodeCreation(this);
 
 	EnhancedPaletteCustomizations::Unregister();
+
+	FIconCatalog::Shutdown();
 }
 
 FPaletteScopedTimeLogger::FPaletteScopedTimeLogger(EMode InMode, FString InMsg,  ELogVerbosity::Type InVerbosity)
@@ -4,6 +4,18 @@
 
 #include "EnhancedPaletteGlobals.h"
 #include "Modules/ModuleManager.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+
+// Insights channel for palette work, enable with -trace=cpu,EnhancedPalette
+UE_TRACE_CHANNEL_EXTERN(EnhancedPaletteChannel);
+
+// CPU profiler scope on palette channel
+#define EPP_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, EnhancedPaletteChannel)
+// CPU profiler scope with runtime name on palette channel, name is only built while channel is enabled
+#define EPP_TRACE_SCOPE_TEXT(Text) TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(UE_TRACE_CHANNELEXPR_IS_ENABLED(EnhancedPaletteChannel) ? (Text) : TEXT(""), EnhancedPaletteChannel)
+
+DECLARE_STATS_GROUP(TEXT("EnhancedPalette"), STATGROUP_EnhancedPalette, STATCAT_Advanced);
 
 class FEnhancedPaletteModule : public FDefaultModuleImpl
 {
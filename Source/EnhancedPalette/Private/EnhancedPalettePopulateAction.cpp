@@ -0,0 +1,131 @@
+﻿// Copyright 2025, Aquanox.
+
+#include "EnhancedPalettePopulateAction.h"
+
+#include "EnhancedPaletteGlobals.h"
+#include "EnhancedPaletteSubsystem.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EnhancedPalettePopulateAction)
+
+UEnhancedPalettePopulateAction* UEnhancedPalettePopulateAction::WaitForPopulate(const TArray<FName>& Categories, bool bDiscover, float TimeoutSeconds)
+{
+	UEnhancedPalettePopulateAction* Action = NewObject<UEnhancedPalettePopulateAction>();
+	Action->Categories = Categories;
+	Action->bDiscover = bDiscover;
+	Action->TimeoutSeconds = TimeoutSeconds;
+	// there is no game instance in editor to keep action alive
+	Action->AddToRoot();
+	return Action;
+}
+
+void UEnhancedPalettePopulateAction::Activate()
+{
+	UEnhancedPaletteSubsystem* Subsystem = UEnhancedPaletteSubsystem::Get();
+	if (!Subsystem)
+	{
+		UE_LOG(LogEnhancedPalette, Warning, TEXT("WaitForPopulate: subsystem is not available"));
+		FinishDeferred(true);
+		return;
+	}
+
+	StartTime = FPlatformTime::Seconds();
+
+	HandleOnCategoryPopulated = Subsystem->OnCategoryPopulated().AddUObject(this, &ThisClass::HandleCategoryPopulated);
+	HandleOnPostTick = Subsystem->OnPostTick().AddUObject(this, &ThisClass::HandlePostTick);
+
+	if (bDiscover)
+	{
+		Subsystem->RequestDiscover();
+	}
+
+	if (Categories.IsEmpty())
+	{
+		Subsystem->MarkCategoryDirty(EManagedCategoryFlags::Type_Any, EManagedCategoryDirtyFlags::Content);
+	}
+	else
+	{
+		for (const FName& Category : Categories)
+		{
+			Subsystem->MarkCategoryDirty(Category, EManagedCategoryDirtyFlags::Content);
+		}
+	}
+
+	// caller waits for it, so do not postpone while placement browser is hidden
+	Subsystem->AddForcedPopulateHold();
+	bHoldingForcedPopulate = true;
+}
+
+void UEnhancedPalettePopulateAction::HandleCategoryPopulated(const FPaletteCategoryPopulateResult& Result)
+{
+	if (Categories.IsEmpty() || Categories.Contains(Result.CategoryId))
+	{
+		// category may be populated more than once while waiting, keep the latest
+		if (FPaletteCategoryPopulateResult* Existing = Results.FindByPredicate([&Result](const FPaletteCategoryPopulateResult& Item) { return Item.CategoryId == Result.CategoryId; }))
+		{
+			*Existing = Result;
+		}
+		else
+		{
+			Results.Add(Result);
+		}
+	}
+}
+
+void UEnhancedPalettePopulateAction::HandlePostTick(bool bIdle)
+{
+	if (!Categories.IsEmpty())
+	{
+		bIdle = UEnhancedPaletteSubsystem::Get()->IsPopulateIdle(Categories);
+	}
+
+	if (bIdle)
+	{
+		Finish(false);
+	}
+	else if (TimeoutSeconds > 0.f && FPlatformTime::Seconds() - StartTime > TimeoutSeconds)
+	{
+		UE_LOG(LogEnhancedPalette, Warning, TEXT("WaitForPopulate: timed out after %.1f seconds"), TimeoutSeconds);
+		Finish(true);
+	}
+}
+
+void UEnhancedPalettePopulateAction::Finish(bool bTimedOut)
+{
+	if (bFinished)
+	{
+		return;
+	}
+	bFinished = true;
+
+	if (UEnhancedPaletteSubsystem* Subsystem = UEnhancedPaletteSubsystem::Get())
+	{
+		Subsystem->OnCategoryPopulated().Remove(HandleOnCategoryPopulated);
+		Subsystem->OnPostTick().Remove(HandleOnPostTick);
+		if (bHoldingForcedPopulate)
+		{
+			Subsystem->RemoveForcedPopulateHold();
+		}
+	}
+	bHoldingForcedPopulate = false;
+
+	if (bTimedOut)
+	{
+		TimedOut.Broadcast(Results);
+	}
+	else
+	{
+		Completed.Broadcast(Results);
+	}
+
+	RemoveFromRoot();
+	SetReadyToDestroy();
+}
+
+void UEnhancedPalettePopulateAction::FinishDeferred(bool bTimedOut)
+{
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this, bTimedOut](float)
+	{
+		Finish(bTimedOut);
+		return false;
+	}));
+}
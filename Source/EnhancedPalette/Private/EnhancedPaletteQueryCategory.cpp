@@ -0,0 +1,513 @@
+﻿// Copyright 2025, Aquanox.
+
+#include "EnhancedPaletteQueryCategory.h"
+
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "EnhancedPaletteGlobals.h"
+#include "EnhancedPaletteModule.h"
+#include "EnhancedPaletteSubsystem.h"
+#include "PaletteTagIndex.h"
+#include "Algo/Sort.h"
+#include "Misc/PackageName.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EnhancedPaletteQueryCategory)
+
+bool FPaletteQueryTagPredicate::Matches(const FAssetData& InAsset) const
+{
+	FString TagValue;
+	const bool bHasTag = InAsset.GetTagValue(Tag, TagValue);
+
+	switch (Operation)
+	{
+	case EPaletteQueryTagOperation::Exists:
+		return bHasTag;
+	case EPaletteQueryTagOperation::Equals:
+		return bHasTag && TagValue.Equals(Value, ESearchCase::IgnoreCase);
+	case EPaletteQueryTagOperation::NotEquals:
+		return !bHasTag || !TagValue.Equals(Value, ESearchCase::IgnoreCase);
+	case EPaletteQueryTagOperation::Contains:
+		return bHasTag && TagValue.Contains(Value, ESearchCase::IgnoreCase);
+	}
+	return false;
+}
+
+UEnhancedPaletteQueryCategory::UEnhancedPaletteQueryCategory()
+{
+	// result is kept up to date from registry events, generic asset tracking would regather on any change
+	bTrackingAssetChanges = false;
+}
+
+void UEnhancedPaletteQueryCategory::NativeInitialize()
+{
+	Super::NativeInitialize();
+
+	if (HasAnyFlags(RF_ClassDefaultObject))
+		return;
+
+	IAssetRegistry& Registry = IAssetRegistry::GetChecked();
+	Registry.OnAssetAdded().AddUObject(this, &ThisClass::HandleAssetAdded);
+	Registry.OnAssetRemoved().AddUObject(this, &ThisClass::HandleAssetRemoved);
+	Registry.OnAssetUpdated().AddUObject(this, &ThisClass::HandleAssetUpdated);
+	Registry.OnAssetRenamed().AddUObject(this, &ThisClass::HandleAssetRenamed);
+}
+
+void UEnhancedPaletteQueryCategory::GetIndexedAssetTags(TArray<FName>& OutTags) const
+{
+	Super::GetIndexedAssetTags(OutTags);
+
+	// value lookups of predicates can be answered by tag index
+	for (const FPaletteQueryTagPredicate& Predicate : TagPredicates)
+	{
+		if (!Predicate.Tag.IsNone()
+			&& (Predicate.Operation == EPaletteQueryTagOperation::Equals || Predicate.Operation == EPaletteQueryTagOperation::Exists))
+		{
+			OutTags.AddUnique(Predicate.Tag);
+		}
+	}
+}
+
+void UEnhancedPaletteQueryCategory::BeginDestroy()
+{
+	if (IAssetRegistry* Registry = IAssetRegistry::Get())
+	{
+		Registry->OnAssetAdded().RemoveAll(this);
+		Registry->OnAssetRemoved().RemoveAll(this);
+		Registry->OnAssetUpdated().RemoveAll(this);
+		Registry->OnAssetRenamed().RemoveAll(this);
+	}
+
+	Super::BeginDestroy();
+}
+
+void UEnhancedPaletteQueryCategory::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	InvalidateQuery();
+
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+}
+
+void UEnhancedPaletteQueryCategory::InvalidateQuery()
+{
+	bQueryDirty = true;
+	bDerivedClassesDirty = true;
+	Matches.Empty();
+}
+
+FARFilter UEnhancedPaletteQueryCategory::MakeFilter() const
+{
+	FARFilter Filter;
+	for (const TSoftClassPtr<UObject>& Class : AssetClasses)
+	{
+		if (!Class.IsNull())
+		{
+			Filter.ClassPaths.Add(Class.ToSoftObjectPath().GetAssetPath());
+		}
+	}
+	if (Filter.ClassPaths.IsEmpty() && !BlueprintParentClasses.IsEmpty())
+	{
+		Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+	}
+	Filter.bRecursiveClasses = bIncludeSubclasses;
+
+	for (const FDirectoryPath& Path : PackagePaths)
+	{
+		if (!Path.Path.IsEmpty())
+		{
+			FString PathString = Path.Path;
+			PathString.RemoveFromEnd(TEXT("/"));
+			Filter.PackagePaths.Add(*PathString);
+		}
+	}
+	Filter.bRecursivePaths = bRecursivePaths;
+	Filter.bIncludeOnlyOnDiskAssets = true;
+	return Filter;
+}
+
+void UEnhancedPaletteQueryCategory::UpdateDerivedClasses()
+{
+	if (!bDerivedClassesDirty)
+		return;
+
+	bDerivedClassesDirty = false;
+	DerivedClasses.Reset();
+
+	TArray<FTopLevelAssetPath> BaseClasses;
+	for (const TSoftClassPtr<UObject>& Class : BlueprintParentClasses)
+	{
+		if (!Class.IsNull())
+		{
+			BaseClasses.Add(Class.ToSoftObjectPath().GetAssetPath());
+		}
+	}
+
+	if (BaseClasses.Num())
+	{
+		// registry resolves blueprint hierarchies without loading classes
+		IAssetRegistry::GetChecked().GetDerivedClassNames(BaseClasses, TSet<FTopLevelAssetPath>(), DerivedClasses);
+	}
+}
+
+bool UEnhancedPaletteQueryCategory::PassesQuery(const FAssetData& InAsset)
+{
+	return IAssetRegistry::GetChecked().IsAssetIncludedByFilter(InAsset, CompiledFilter) && PassesPredicates(InAsset);
+}
+
+bool UEnhancedPaletteQueryCategory::PassesPredicates(const FAssetData& InAsset)
+{
+	for (const FPaletteQueryTagPredicate& Predicate : TagPredicates)
+	{
+		if (!Predicate.Matches(InAsset))
+		{
+			return false;
+		}
+	}
+
+	if (BlueprintParentClasses.Num())
+	{
+		FString GeneratedClassPath;
+		if (!InAsset.GetTagValue(FBlueprintTags::GeneratedClassPath, GeneratedClassPath))
+		{
+			return false;
+		}
+
+		UpdateDerivedClasses();
+		if (!DerivedClasses.Contains(FTopLevelAssetPath(FPackageName::ExportTextPathToObjectPath(GeneratedClassPath))))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void UEnhancedPaletteQueryCategory::PrepareQuery(const FARFilter& InFilter)
+{
+	IAssetRegistry::GetChecked().CompileFilter(InFilter, CompiledFilter);
+
+	bDerivedClassesDirty = true;
+	Matches.Reset();
+}
+
+void UEnhancedPaletteQueryCategory::EvaluateQuery()
+{
+	FPaletteScopedTimeLogger ScopedLog(FPaletteScopedTimeLogger::END, FString::Printf(TEXT("Evaluating query %s"), *GetName()), ELogVerbosity::Verbose);
+
+	const FARFilter Filter = MakeFilter();
+	PrepareQuery(Filter);
+	bQueryDirty = false;
+
+	if (EvaluateQueryFromTagIndex())
+		return;
+
+	IAssetRegistry::GetChecked().EnumerateAssets(Filter, [this](const FAssetData& Asset)
+	{
+		if (PassesPredicates(Asset))
+		{
+			Matches.Add(Asset.ToSoftObjectPath(), Asset);
+		}
+		return true;
+	});
+}
+
+bool UEnhancedPaletteQueryCategory::EvaluateQueryFromTagIndex()
+{
+	UEnhancedPaletteSubsystem* Subsystem = UEnhancedPaletteSubsystem::Get();
+	if (!Subsystem)
+		return false;
+
+	// the most selective indexed predicate gives candidates, full query is checked for each of them
+	const FPaletteTagIndex& TagIndex = Subsystem->GetTagIndex();
+	TArray<FSoftObjectPath> Candidates;
+	bool bHasCandidates = false;
+	for (const FPaletteQueryTagPredicate& Predicate : TagPredicates)
+	{
+		TArray<FSoftObjectPath> Found;
+		bool bFound = false;
+		if (Predicate.Operation == EPaletteQueryTagOperation::Equals)
+		{
+			bFound = TagIndex.FindAssets(Predicate.Tag, Predicate.Value, Found);
+		}
+		else if (Predicate.Operation == EPaletteQueryTagOperation::Exists)
+		{
+			bFound = TagIndex.FindAssetsWithTag(Predicate.Tag, Found);
+		}
+
+		if (bFound && (!bHasCandidates || Found.Num() < Candidates.Num()))
+		{
+			Candidates = MoveTemp(Found);
+			bHasCandidates = true;
+		}
+	}
+
+	if (!bHasCandidates)
+		return false;
+
+	IAssetRegistry& Registry = IAssetRegistry::GetChecked();
+	for (const FSoftObjectPath& Path : Candidates)
+	{
+		FAssetData Asset = Registry.GetAssetByObjectPath(Path, true);
+		if (Asset.IsValid() && PassesQuery(Asset))
+		{
+			Matches.Add(Path, MoveTemp(Asset));
+		}
+	}
+	return true;
+}
+
+bool UEnhancedPaletteQueryCategory::NativeBeginSharedEnumeration(FARFilter& OutFilter)
+{
+	if (!bQueryDirty || HasAnyFlags(RF_ClassDefaultObject))
+	{
+		// result is maintained incrementally, nothing to enumerate
+		return false;
+	}
+
+	OutFilter = MakeFilter();
+	PrepareQuery(OutFilter);
+
+	if (EvaluateQueryFromTagIndex())
+	{
+		bQueryDirty = false;
+		return false;
+	}
+	return true;
+}
+
+void UEnhancedPaletteQueryCategory::NativeReceiveSharedAsset(const FAssetData& InAsset)
+{
+	// registry filter was already checked by subsystem
+	if (PassesPredicates(InAsset))
+	{
+		Matches.Add(InAsset.ToSoftObjectPath(), InAsset);
+	}
+}
+
+void UEnhancedPaletteQueryCategory::NativeEndSharedEnumeration()
+{
+	bQueryDirty = false;
+}
+
+void UEnhancedPaletteQueryCategory::NativeDiscardSharedEnumeration()
+{
+	// matches were never gathered, evaluate again rather than trust enumeration made before the change
+	Matches.Reset();
+	bQueryDirty = true;
+}
+
+bool UEnhancedPaletteQueryCategory::UpdateMatch(const FAssetData& InAsset, bool bContentChanged)
+{
+	const FSoftObjectPath Path = InAsset.ToSoftObjectPath();
+	if (PassesQuery(InAsset))
+	{
+		FAssetData* Existing = Matches.Find(Path);
+		if (Existing && !bContentChanged)
+		{
+			return false;
+		}
+		Matches.Add(Path, InAsset);
+		return true;
+	}
+	return Matches.Remove(Path) > 0;
+}
+
+void UEnhancedPaletteQueryCategory::HandleAssetAdded(const FAssetData& InAsset)
+{
+	if (bQueryDirty)
+		return;
+
+	if (InAsset.IsInstanceOf(UBlueprint::StaticClass()))
+	{
+		// new blueprint may extend hierarchy of parent classes
+		bDerivedClassesDirty = true;
+	}
+
+	if (UpdateMatch(InAsset, false))
+	{
+		NotifyContentChanged();
+	}
+}
+
+void UEnhancedPaletteQueryCategory::HandleAssetRemoved(const FAssetData& InAsset)
+{
+	if (!bQueryDirty && Matches.Remove(InAsset.ToSoftObjectPath()) > 0)
+	{
+		NotifyContentChanged();
+	}
+}
+
+void UEnhancedPaletteQueryCategory::HandleAssetUpdated(const FAssetData& InAsset)
+{
+	if (bQueryDirty)
+		return;
+
+	if (InAsset.IsInstanceOf(UBlueprint::StaticClass()))
+	{
+		// reparented blueprint changes hierarchy
+		bDerivedClassesDirty = true;
+	}
+
+	// tags may have changed, matched asset is refreshed as display name may depend on them
+	if (UpdateMatch(InAsset, true))
+	{
+		NotifyContentChanged();
+	}
+}
+
+void UEnhancedPaletteQueryCategory::HandleAssetRenamed(const FAssetData& InAsset, const FString& InOldObjectPath)
+{
+	if (bQueryDirty)
+		return;
+
+	const bool bRemoved = Matches.Remove(FSoftObjectPath(InOldObjectPath)) > 0;
+	if (UpdateMatch(InAsset, true) || bRemoved)
+	{
+		NotifyContentChanged();
+	}
+}
+
+FString UEnhancedPaletteQueryCategory::MakeDisplayName(const FAssetData& InAsset) const
+{
+	FString Name = InAsset.AssetName.ToString();
+	if (bStripAssetPrefix)
+	{
+		int32 Index;
+		if (Name.FindChar(TEXT('_'), Index) && Index > 0 && Index + 1 < Name.Len())
+		{
+			Name.RightChopInline(Index + 1);
+		}
+	}
+
+	if (DisplayNameFormat.IsEmpty() || DisplayNameFormat == TEXT("{Name}"))
+	{
+		return Name;
+	}
+
+	FString Result = DisplayNameFormat;
+	Result.ReplaceInline(TEXT("{Name}"), *Name);
+	Result.ReplaceInline(TEXT("{Class}"), *InAsset.AssetClassPath.GetAssetName().ToString());
+	Result.ReplaceInline(TEXT("{Folder}"), *FPackageName::GetShortName(InAsset.PackagePath));
+
+	static const FString TagTokenStart = TEXT("{Tag:");
+	for (int32 Start = Result.Find(TagTokenStart); Start != INDEX_NONE; Start = Result.Find(TagTokenStart, ESearchCase::CaseSensitive, ESearchDir::FromStart, Start))
+	{
+		const int32 End = Result.Find(TEXT("}"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Start);
+		if (End == INDEX_NONE)
+			break;
+
+		const FName TagName = *Result.Mid(Start + TagTokenStart.Len(), End - Start - TagTokenStart.Len());
+		FString TagValue;
+		InAsset.GetTagValue(TagName, TagValue);
+		Result = Result.Left(Start) + TagValue + Result.Mid(End + 1);
+		Start += TagValue.Len();
+	}
+	return Result;
+}
+
+void UEnhancedPaletteQueryCategory::SortMatches(TArray<const FAssetData*>& InOutAssets) const
+{
+	if (SortRule == EPaletteQuerySortRule::None)
+		return;
+
+	struct FSortKey
+	{
+		const FAssetData* Asset;
+		FString Primary;
+		FString Name;
+	};
+
+	TArray<FSortKey> Keys;
+	Keys.Reserve(InOutAssets.Num());
+	for (const FAssetData* Asset : InOutAssets)
+	{
+		FSortKey& Key = Keys.AddDefaulted_GetRef();
+		Key.Asset = Asset;
+		Key.Name = MakeDisplayName(*Asset);
+		switch (SortRule)
+		{
+		case EPaletteQuerySortRule::Class:
+			Key.Primary = Asset->AssetClassPath.GetAssetName().ToString();
+			break;
+		case EPaletteQuerySortRule::Path:
+			Key.Primary = Asset->PackagePath.ToString();
+			break;
+		case EPaletteQuerySortRule::TagValue:
+			Asset->GetTagValue(SortTag, Key.Primary);
+			break;
+		default:
+			break;
+		}
+	}
+
+	const bool bDescending = bSortDescending;
+	Algo::Sort(Keys, [bDescending](const FSortKey& A, const FSortKey& B)
+	{
+		int32 Result = A.Primary.Compare(B.Primary, ESearchCase::IgnoreCase);
+		if (Result == 0)
+		{
+			Result = A.Name.Compare(B.Name, ESearchCase::IgnoreCase);
+		}
+		return bDescending ? Result > 0 : Result < 0;
+	});
+
+	for (int32 Index = 0; Index < Keys.Num(); ++Index)
+	{
+		InOutAssets[Index] = Keys[Index].Asset;
+	}
+}
+
+bool UEnhancedPaletteQueryCategory::CanAddItem(const TConfigPlaceableItem& Item)
+{
+	if (bAddingMatches)
+	{
+		// matches are unique by object path, skip duplicate search
+		return Item.IsValid() && Item.Get<FConfigPlaceableItem>().IsValidData();
+	}
+	return Super::CanAddItem(Item);
+}
+
+void UEnhancedPaletteQueryCategory::NativeGatherItems()
+{
+	Super::NativeGatherItems();
+
+	if (HasAnyFlags(RF_ClassDefaultObject))
+		return;
+
+	if (bQueryDirty)
+	{
+		EvaluateQuery();
+	}
+
+	TArray<const FAssetData*> Assets;
+	Assets.Reserve(Matches.Num());
+	for (const TPair<FSoftObjectPath, FAssetData>& Pair : Matches)
+	{
+		Assets.Add(&Pair.Value);
+	}
+	SortMatches(Assets);
+
+	TGuardValue<bool> AddingMatches(bAddingMatches, true);
+
+	const bool bAssignOrder = SortRule != EPaletteQuerySortRule::None;
+	for (int32 Index = 0; Index < Assets.Num() && !IsGatherCancelled(); ++Index)
+	{
+		const FAssetData& Asset = *Assets[Index];
+
+		const FString Name = MakeDisplayName(Asset);
+		// keep default name when not customized
+		const FText ItemName = Name.Equals(Asset.AssetName.ToString()) ? FText::GetEmpty() : FText::FromString(Name);
+		const int32 ItemSortOrder = bAssignOrder ? SortOrderStart + Index : 0;
+
+		if (FactoryOverride.IsNull())
+		{
+			AddAssetData(Asset, NAME_None, ItemName, ItemSortOrder);
+		}
+		else
+		{
+			FConfigPlaceableItem_FactoryAssetData Cfg(FactoryOverride, Asset);
+			Cfg.DisplayName = ItemName;
+			Cfg.SortOrder = ItemSortOrder;
+			AddInternal(TConfigPlaceableItem::Make<FConfigPlaceableItem_FactoryAssetData>(MoveTemp(Cfg)));
+		}
+	}
+}
@@ -18,14 +18,43 @@
 #include "ISettingsSection.h"
 #include "LevelEditor.h"
 #include "Misc/ConfigCacheIni.h"
+#include "Misc/PackageName.h"
 #include "PlacementModeModuleAccess.h"
+#include "PaletteContentSnapshot.h"
+#include "PaletteSearchIndex.h"
+#include "PaletteSharedEnumeration.h"
+#include "PaletteTagIndex.h"
+#include "PaletteWorldCache.h"
+#include "PaletteWorldIndex.h"
 #include "Subsystems/EditorAssetSubsystem.h"
 #include "Subsystems/PlacementSubsystem.h"
 #include "Widgets/SWidget.h"
 #include "HAL/IConsoleManager.h"
+#include "Algo/StableSort.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "UObject/UObjectGlobals.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(EnhancedPaletteSubsystem)
 
+DECLARE_CYCLE_STAT(TEXT("Discover"), STAT_EnhancedPalette_Discover, STATGROUP_EnhancedPalette);
+DECLARE_CYCLE_STAT(TEXT("Populate"), STAT_EnhancedPalette_Populate, STATGROUP_EnhancedPalette);
+DECLARE_CYCLE_STAT(TEXT("Gather"), STAT_EnhancedPalette_Gather, STATGROUP_EnhancedPalette);
+DECLARE_CYCLE_STAT(TEXT("Widget Refresh"), STAT_EnhancedPalette_WidgetRefresh, STATGROUP_EnhancedPalette);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Managed Categories"), STAT_EnhancedPalette_ManagedCategories, STATGROUP_EnhancedPalette);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Registered Items"), STAT_EnhancedPalette_RegisteredItems, STATGROUP_EnhancedPalette);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Dirty Categories"), STAT_EnhancedPalette_DirtyCategories, STATGROUP_EnhancedPalette);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Sync Loads"), STAT_EnhancedPalette_SyncLoads, STATGROUP_EnhancedPalette);
+
+TRACE_DECLARE_INT_COUNTER(EnhancedPalette_ManagedCategories, TEXT("EnhancedPalette/ManagedCategories"));
+TRACE_DECLARE_INT_COUNTER(EnhancedPalette_RegisteredItems, TEXT("EnhancedPalette/RegisteredItems"));
+TRACE_DECLARE_INT_COUNTER(EnhancedPalette_DirtyCategories, TEXT("EnhancedPalette/DirtyCategories"));
+TRACE_DECLARE_INT_COUNTER(EnhancedPalette_SyncLoads, TEXT("EnhancedPalette/SyncLoads"));
+
+// superseded gathers regathered in a row before category keeps its previous content
+static constexpr int32 MaxDiscardedGathers = 3;
+
 static FAutoConsoleCommand EPP_DiscoverCategories(
 	TEXT("EPP.DiscoverCategories"),
 	TEXT("Request discover palette categories"),
@@ -54,6 +83,55 @@ static FAutoConsoleCommand EPP_UpdateToolbar(
 		UEnhancedPaletteSubsystem::Get()->OnSettingsPanelCommand(SettingsCommand::UpdateToolbar);
 	})
 );
+static FAutoConsoleCommand EPP_Search(
+	TEXT("EPP.Search"),
+	TEXT("Search items registered in palette categories, queries shorter than 3 characters match word starts only. Usage: EPP.Search <Query> [MaxResults]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args) {
+		if (Args.IsEmpty())
+		{
+			UE_LOG(LogEnhancedPalette, Display, TEXT("Usage: EPP.Search <Query> [MaxResults]"));
+			return;
+		}
+
+		const int32 MaxResults = Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 50;
+
+		TArray<FPaletteSearchResult> Results;
+		const double Start = FPlatformTime::Seconds();
+		UEnhancedPaletteSubsystem::Get()->SearchPlaceableItems(Args[0], MaxResults, Results);
+		const double Delta = FPlatformTime::Seconds() - Start;
+
+		UE_LOG(LogEnhancedPalette, Display, TEXT("Search '%s': %d results in %.3f ms"), *Args[0], Results.Num(), Delta * 1000.0);
+		for (const FPaletteSearchResult& Result : Results)
+		{
+			UE_LOG(LogEnhancedPalette, Display, TEXT("[%s] %s (%s) %s"),
+				*Result.CategoryId.ToString(), *Result.DisplayName.ToString(), *Result.NativeName, *Result.ObjectPath);
+		}
+	})
+);
+static FAutoConsoleCommand EPP_DumpCounters(
+	TEXT("EPP.DumpCounters"),
+	TEXT("Print subsystem activity counters. Pass 'reset' to reset them afterwards"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args) {
+		UEnhancedPaletteSubsystem* Subsystem = UEnhancedPaletteSubsystem::Get();
+		const FEnhancedPaletteCounters& Counters = Subsystem->GetCounters();
+		UE_LOG(LogEnhancedPalette, Display, TEXT("SettingsImports=%d EngineCategoryApplies=%d ToolbarRefreshes=%d ContentRefreshes=%d SkippedContentRefreshes=%d SuppressedNotifications=%d"),
+			Counters.SettingsImports, Counters.EngineCategoryApplies, Counters.ToolbarRefreshes, Counters.ContentRefreshes, Counters.SkippedContentRefreshes, Counters.SuppressedNotifications);
+		UE_LOG(LogEnhancedPalette, Display, TEXT("KeptItemRegistrations=%d SharedEnumerations=%d SharedEnumerationClients=%d PostponedPopulates=%d CancelledGathers=%d ThrottledCategories=%d SyncLoads=%d"),
+			Counters.KeptItemRegistrations, Counters.SharedEnumerations, Counters.SharedEnumerationClients, Counters.PostponedPopulates, Counters.CancelledGathers, Counters.ThrottledCategories, Counters.SyncLoads);
+		UE_LOG(LogEnhancedPalette, Display, TEXT("Searches=%d SlowSearches=%d"), Counters.Searches, Counters.SlowSearches);
+		if (Args.Contains(TEXT("reset")))
+		{
+			Subsystem->ResetCounters();
+		}
+	})
+);
+static FAutoConsoleCommand EPP_ResumeThrottled(
+	TEXT("EPP.ResumeThrottled"),
+	TEXT("Resume change tracking and restore update intervals of categories throttled for exceeding budgets"),
+	FConsoleCommandDelegate::CreateLambda([]() {
+		UEnhancedPaletteSubsystem::Get()->ResumeThrottledCategories();
+	})
+);
 static FAutoConsoleCommand EPP_ClearRecent(
 	TEXT("EPP.ClearRecent"),
 	TEXT("Request clear recently placed actors list"),
@@ -67,9 +145,27 @@ UEnhancedPaletteSubsystem* UEnhancedPaletteSubsystem::Get()
 	return GEditor->GetEditorSubsystem<UEnhancedPaletteSubsystem>();
 }
 
+UEnhancedPaletteSubsystem::FScopedSelfMutation::FScopedSelfMutation(UEnhancedPaletteSubsystem* InOwner) : Owner(InOwner)
+{
+	++Owner->SelfMutationDepth;
+}
+
+UEnhancedPaletteSubsystem::FScopedSelfMutation::~FScopedSelfMutation()
+{
+	if (--Owner->SelfMutationDepth == 0 && Owner->bPendingCategoryListImport)
+	{
+		Owner->bPendingCategoryListImport = false;
+		if (Owner->bSubsystemReady)
+		{
+			// handle all batched notifications at once
+			Owner->OnSettingsPanelSelected();
+		}
+	}
+}
+
 TStatId UEnhancedPaletteSubsystem::GetStatId() const
 {
-	RETURN_QUICK_DECLARE_CYCLE_STAT(FEnhancedPaletteSubsystemTicker, STATGROUP_Tickables);
+	RETURN_QUICK_DECLARE_CYCLE_STAT(FEnhancedPaletteSubsystemTicker, STATGROUP_EnhancedPalette);
 }
 
 ETickableTickType UEnhancedPaletteSubsystem::GetTickableTickType() const
@@ -86,6 +182,12 @@ void UEnhancedPaletteSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	UE_LOG(LogEnhancedPalette, Verbose, TEXT("Initializing subsystem"));
 
+	SearchIndex = MakeShared<FPaletteSearchIndex>();
+	WorldIndex = MakeShared<FPaletteWorldIndex>();
+	WorldIndex->Initialize();
+	WorldCache = MakeShared<FPaletteWorldCache>();
+	TagIndex = MakeShared<FPaletteTagIndex>();
+
 	// # ensure asset SS is initialized
 	Collection.InitializeDependency<UEditorAssetSubsystem>();
 	Collection.InitializeDependency<UPlacementSubsystem>();
@@ -113,6 +215,9 @@ void UEnhancedPaletteSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
 	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
 
+	// tag index completes its build before category discovery runs on scan completion
+	TagIndex->Initialize();
+
 	if (AssetRegistry.IsLoadingAssets())
 	{
 		// Engine still loading assets - need defer discovery of category assets
@@ -122,6 +227,8 @@ void UEnhancedPaletteSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
 	// # Placement mode module load awaiting - can not force module to load early as it wrecks PM discovery process
 
+	FCoreUObjectDelegates::OnSyncLoadPackage.AddUObject(this, &ThisClass::OnSyncLoadPackage);
+
 	// try access PM right away
 	TrySetupPlacementModule(NAME_None, EModuleChangeReason::ModuleLoaded);
 	if (!ModuleAccessPrivate.IsValid())
@@ -153,6 +260,12 @@ void UEnhancedPaletteSubsystem::TrySetupPlacementModule(FName Name, EModuleChang
 		//
 		OnPlacementModuleReadyPrivate.Broadcast(IPlacementModeModule::Get());
 
+		// fill palette with content of last session while initial asset scan is running
+		if (bPendingAssetLoad)
+		{
+			RestoreContentSnapshots();
+		}
+
 		// import settings data from PM
 		OnSettingsPanelSelected();
 		// register delegates
@@ -175,6 +288,56 @@ void UEnhancedPaletteSubsystem::OnInitialAssetsScanComplete()
 	bPendingAssetLoad = false;
 }
 
+FName UEnhancedPaletteSubsystem::GetEditorMapName()
+{
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!World)
+	{
+		return NAME_None;
+	}
+
+	const FName PackageName = World->GetOutermost()->GetFName();
+	// unsaved maps reuse temporary names
+	return FPackageName::IsTempPackage(PackageName.ToString()) ? NAME_None : PackageName;
+}
+
+void UEnhancedPaletteSubsystem::OnEditorMapClosing()
+{
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	const FName MapName = GetEditorMapName();
+	if (World && !MapName.IsNone() && World->GetOutermost()->IsDirty())
+	{
+		// unsaved changes may be discarded, cached content would not match map on reopen
+		WorldCache->RemoveMap(MapName);
+		return;
+	}
+
+	for (const TSharedPtr<FManagedCategory>& Ptr : ManagedCategories)
+	{
+		if (Ptr->HasFlag(EManagedCategoryFlags::DynamicTrait_World) && (Ptr->bDirtyContent || Ptr->bThrottled))
+		{
+			// cached content predates changes not yet gathered or ignored while throttled
+			WorldCache->Remove(MapName, Ptr->UniqueId);
+		}
+	}
+}
+
+void UEnhancedPaletteSubsystem::OnEditorMapOpened()
+{
+	const FName MapName = GetEditorMapName();
+
+	for (const TSharedPtr<FManagedCategory>& Ptr : ManagedCategories)
+	{
+		if (Ptr->HasFlag(EManagedCategoryFlags::DynamicTrait_World))
+		{
+			Ptr->bDirtyContent = true;
+			Ptr->bRestoreFromWorldCache = WorldCache->Contains(MapName, Ptr->UniqueId);
+			Ptr->BumpGeneration();
+			RequestPopulate();
+		}
+	}
+}
+
 TSharedPtr<FManagedCategory> UEnhancedPaletteSubsystem::FindManagedCategory(const FName& InId) const
 {
 	for (const TSharedPtr<FManagedCategory>& Ptr : ManagedCategories)
@@ -194,6 +357,8 @@ void UEnhancedPaletteSubsystem::MarkCategoryDirty(FName UniqueId, EManagedCatego
 		if (EnumHasAnyFlags(DirtyFlags, EManagedCategoryDirtyFlags::Content))
 		{
 			Found->bDirtyContent = true;
+			Found->bRestoreFromWorldCache = false;
+			Found->BumpGeneration();
 			RequestPopulate();
 		}
 
@@ -207,13 +372,18 @@ void UEnhancedPaletteSubsystem::MarkCategoryDirty(FName UniqueId, EManagedCatego
 
 void UEnhancedPaletteSubsystem::MarkCategoryDirty(EManagedCategoryFlags Trait, EManagedCategoryDirtyFlags DirtyFlags)
 {
+	// throttled categories ignore tracked changes, explicit requests still reach them
+	const bool bTrackedChange = EnumHasAnyFlags(Trait, EManagedCategoryFlags::DynamicTrait_Tracking);
+
 	for (const TSharedPtr<FManagedCategory>& Ptr : ManagedCategories)
 	{
-		if (Ptr->HasFlag(Trait))
+		if (Ptr->HasFlag(Trait) && !(bTrackedChange && Ptr->bThrottled))
 		{
 			if (EnumHasAnyFlags(DirtyFlags, EManagedCategoryDirtyFlags::Content))
 			{
 				Ptr->bDirtyContent = true;
+				Ptr->bRestoreFromWorldCache = false;
+				Ptr->BumpGeneration();
 				RequestPopulate();
 			}
 
@@ -226,21 +396,61 @@ void UEnhancedPaletteSubsystem::MarkCategoryDirty(EManagedCategoryFlags Trait, E
 	}
 }
 
+void UEnhancedPaletteSubsystem::MarkCategoryDirtyForBlueprints(TConstArrayView<FCompiledBlueprintInfo> Compiled)
+{
+	if (Compiled.IsEmpty())
+	{
+		// compiled without prior notification, can not tell what changed
+		MarkCategoryDirty(EManagedCategoryFlags::DynamicTrait_Blueprint, EManagedCategoryDirtyFlags::Content);
+		return;
+	}
+
+	for (const TSharedPtr<FManagedCategory>& Ptr : ManagedCategories)
+	{
+		if (!Ptr->HasFlag(EManagedCategoryFlags::DynamicTrait_Blueprint) || Ptr->bDirtyContent || Ptr->bThrottled)
+			continue;
+
+		for (const FCompiledBlueprintInfo& Info : Compiled)
+		{
+			if (Ptr->IsInterestedInBlueprint(Info))
+			{
+				UE_LOG(LogEnhancedPalette, Verbose, TEXT("Tracking: %s affected by %s"), *Ptr->UniqueId.ToString(), *Info.PackageName.ToString());
+				MarkCategoryDirty(Ptr->UniqueId, EManagedCategoryDirtyFlags::Content);
+				break;
+			}
+		}
+	}
+}
+
 void UEnhancedPaletteSubsystem::Tick(float DeltaTime)
 {
 	// do nothing if still waiting for assets to be ready
 	if (bPendingAssetLoad || !bSubsystemReady)
 	{
+		OnPostTickPrivate.Broadcast(false);
 		return;
 	}
 
+	EPP_TRACE_SCOPE(EnhancedPalette_Tick);
+	TGuardValue<bool> WorkScope(bInPaletteWork, true);
+
 	const float Start = FPlatformTime::Seconds();
 
-	for (const TSharedPtr<FManagedCategory>& Ptr : ManagedCategories)
 	{
-		if (Ptr->HasFlag(EManagedCategoryFlags::DynamicTrait_Interval))
+		EPP_TRACE_SCOPE(EnhancedPalette_TickCategories);
+		for (const TSharedPtr<FManagedCategory>& Ptr : ManagedCategories)
 		{
-			Ptr->Tick(DeltaTime);
+			if (Ptr->HasFlag(EManagedCategoryFlags::DynamicTrait_Interval))
+			{
+				EPP_TRACE_SCOPE_TEXT(*Ptr->UniqueId.ToString());
+				TGuardValue<FName> CategoryScope(WorkingCategory, Ptr->UniqueId);
+
+				const double TickStart = FPlatformTime::Seconds();
+				if (Ptr->Tick(DeltaTime))
+				{
+					CheckTickBudget(*Ptr, FPlatformTime::Seconds() - TickStart);
+				}
+			}
 		}
 	}
 
@@ -249,17 +459,34 @@ void UEnhancedPaletteSubsystem::Tick(float DeltaTime)
 		bRequireDiscover = false;
 		TryDiscoverCategories();
 	}
+	const bool bShown = UpdatePaletteShown();
 	if (bRequirePopulate)
 	{
 		bRequirePopulate = false;
-		TryPopulateCategoryItems();
+		if (TryPopulateCategoryItems(!bShown && !bForcePopulate && ForcedPopulateHolds == 0 && GetDefault<UEnhancedPaletteSettings>()->bDeferUpdatesWhileHidden))
+		{
+			bForcePopulate = false;
+		}
+		else
+		{
+			// frame budget exceeded, continue next tick
+			RequestPopulate();
+		}
+	}
+	if (bRequireApplyExternalDeltas)
+	{
+		bRequireApplyExternalDeltas = false;
+		ApplyExternalCategoryDeltas();
 	}
-	if (bRequireUpdateEngineCategories)
+	// settings edits are applied once they settle
+	const bool bSettingsSettled = AreSettingsEditsSettled();
+
+	if (bRequireUpdateEngineCategories && bSettingsSettled)
 	{
 		bRequireUpdateEngineCategories = false;
 		ApplyEngineCategorySettings();
 	}
-	if (bRequireUpdateManagedCategories)
+	if (bRequireUpdateManagedCategories && bSettingsSettled)
 	{
 		bRequireUpdateManagedCategories = false;
 		ApplyManagedCategorySettings();
@@ -269,20 +496,49 @@ void UEnhancedPaletteSubsystem::Tick(float DeltaTime)
 		bRequireApplyRecentList = false;
 		ApplyRecentListSettings();
 	}
-	if (bRequireSettingsSave)
+	if (bRequireSettingsSave && bSettingsSettled)
 	{
 		bRequireSettingsSave = false;
 		TrySaveSettings();
 	}
-	if (bRequireToolbarRefresh)
+	// widget refreshes are rate limited, pending requests stay until interval passes or browser is shown
+	if (bRequireToolbarRefresh && bShown && IsWidgetRefreshAllowed(LastToolbarRefreshTime))
 	{
+		EPP_TRACE_SCOPE(EnhancedPalette_ToolbarRefresh);
+		SCOPE_CYCLE_COUNTER(STAT_EnhancedPalette_WidgetRefresh);
 		bRequireToolbarRefresh = false;
+		LastToolbarRefreshTime = FPlatformTime::Seconds();
+		++Counters.ToolbarRefreshes;
+		FScopedSelfMutation SelfMutation(this);
 		GetModuleRef().NotifyCategoriesChanged();
 	}
-	if (bRequireToolbarContentRefresh)
+	if ((bRequireToolbarContentRefresh || !ContentRefreshCategories.IsEmpty()) && bShown && IsWidgetRefreshAllowed(LastContentRefreshTime))
 	{
+		FPlacementModeModuleAccess& Access = GetModuleRef();
+		// content of hidden categories is rebuilt by engine when they get selected
+		if (bRequireToolbarContentRefresh || ContentRefreshCategories.Contains(Access.TryGetActiveCategory()))
+		{
+			EPP_TRACE_SCOPE(EnhancedPalette_ContentRefresh);
+			SCOPE_CYCLE_COUNTER(STAT_EnhancedPalette_WidgetRefresh);
+			LastContentRefreshTime = FPlatformTime::Seconds();
+			++Counters.ContentRefreshes;
+			Access.TryForceContentRefresh();
+		}
+		else
+		{
+			++Counters.SkippedContentRefreshes;
+		}
 		bRequireToolbarContentRefresh = false;
-		GetModuleRef().TryForceContentRefresh();
+		ContentRefreshCategories.Reset();
+	}
+
+	GetModuleRef().FlushPendingConfig();
+
+	UpdateStats();
+
+	if (OnPostTickPrivate.IsBound())
+	{
+		OnPostTickPrivate.Broadcast(IsPopulateIdle());
 	}
 
 	const float Delta = FPlatformTime::Seconds() - Start;
@@ -294,12 +550,15 @@ void UEnhancedPaletteSubsystem::Tick(float DeltaTime)
 
 void UEnhancedPaletteSubsystem::TryDiscoverCategories()
 {
+	EPP_TRACE_SCOPE(EnhancedPalette_Discover);
+	SCOPE_CYCLE_COUNTER(STAT_EnhancedPalette_Discover);
 	FPaletteScopedTimeLogger ScopedLog(FPaletteScopedTimeLogger::START_END, TEXT("Discovering categories"), ELogVerbosity::Verbose);
 
 	ensure(bSubsystemReady);
 	ensure(!bPendingAssetLoad);
 
 	FPlacementModeModuleAccess& Access = GetModuleRef();
+	FScopedSelfMutation SelfMutation(this);
 
 	TArray<TSharedPtr<FManagedCategory>> NewDiscoveredCategories;
 
@@ -323,20 +582,33 @@ void UEnhancedPaletteSubsystem::TryDiscoverCategories()
 	for (auto It = ManagedCategories.CreateIterator(); It; ++It)
 	{
 		TSharedPtr<FManagedCategory> Item = *It;
-		if (Item->HasFlag(EManagedCategoryFlags::Type_External) && static_cast<FExternalCategory&>(*Item).bPendingKill)
+		if (Item->HasFlag(EManagedCategoryFlags::Type_External))
 		{
-			continue;
+			// external categories live until removed through API, created ones get registered here
+			if (!static_cast<FExternalCategory&>(*Item).bPendingKill)
+			{
+				if (!Item->bRegistered)
+				{
+					UE_LOG(LogEnhancedPalette, Verbose, TEXT("Discover: added external category %s"), *Item->UniqueId.ToString());
+					Item->bDirtyContent = true;
+					Item->Register(this, Access);
+					bChanged = true;
+				}
+				continue;
+			}
 		}
-		if (NewDiscoveredCategories.FindByKey(Item->UniqueId) == nullptr)
+		else if (NewDiscoveredCategories.FindByKey(Item->UniqueId) != nullptr)
 		{
-			// category existed but no longer in new cycle - unregister & remove
-			UE_LOG(LogEnhancedPalette, Verbose, TEXT("Discover: removed outdated category %s"), *Item->UniqueId.ToString());
+			continue;
+		}
 
-			Item->Unregister(this, Access);
-			It.RemoveCurrent();
+		// category existed but no longer in new cycle or was removed - unregister & remove
+		UE_LOG(LogEnhancedPalette, Verbose, TEXT("Discover: removed outdated category %s"), *Item->UniqueId.ToString());
 
-			bChanged = true;
-		}
+		Item->Unregister(this, Access);
+		It.RemoveCurrent();
+
+		bChanged = true;
 	}
 
 	// find categories that were added
@@ -358,6 +630,8 @@ void UEnhancedPaletteSubsystem::TryDiscoverCategories()
 
 	NewDiscoveredCategories.Reset();
 
+	bChanged |= DiscardRestoredCategories();
+
 	if (bChanged)
 	{
 		RequestToolbarRefresh();
@@ -367,6 +641,7 @@ void UEnhancedPaletteSubsystem::TryDiscoverCategories()
 
 void UEnhancedPaletteSubsystem::TryDiscoverFromConfig(TArray<TSharedPtr<FManagedCategory>>& OutCategories) const
 {
+	EPP_TRACE_SCOPE(EnhancedPalette_DiscoverFromConfig);
 	FPaletteScopedTimeLogger ScopedLog(FPaletteScopedTimeLogger::END, TEXT("Searching in config"), ELogVerbosity::Verbose);
 
 	for (const FConfigPlacementCategoryInfo& Descriptor : GetDefault<UEnhancedPaletteSettings>()->StaticCategories)
@@ -399,6 +674,7 @@ void UEnhancedPaletteSubsystem::TryDiscoverFromConfig(TArray<TSharedPtr<FManaged
 
 void UEnhancedPaletteSubsystem::TryDiscoverFromNativeScan(TArray<TSharedPtr<FManagedCategory>>& OutCategories) const
 {
+	EPP_TRACE_SCOPE(EnhancedPalette_DiscoverFromNativeScan);
 	FPaletteScopedTimeLogger ScopedLog(FPaletteScopedTimeLogger::END, TEXT("Searching in native"), ELogVerbosity::Verbose);
 
 	TArray<UClass*> NativeCategories;
@@ -421,6 +697,7 @@ void UEnhancedPaletteSubsystem::TryDiscoverFromNativeScan(TArray<TSharedPtr<FMan
 
 void UEnhancedPaletteSubsystem::TryDiscoverFromAssetScan(TArray<TSharedPtr<FManagedCategory>>& OutCategories) const
 {
+	EPP_TRACE_SCOPE(EnhancedPalette_DiscoverFromAssetScan);
 	FPaletteScopedTimeLogger ScopedLog(FPaletteScopedTimeLogger::END, TEXT("Searching in assets"), ELogVerbosity::Verbose);
 
 	TArray<FAssetData> AllBPsAssetData;
@@ -460,227 +737,1104 @@ void UEnhancedPaletteSubsystem::TryDiscoverFromAssetScan(TArray<TSharedPtr<FMana
 	}
 }
 
-void UEnhancedPaletteSubsystem::TryPopulateCategoryItems()
+TSharedPtr<FPlaceableItem> UEnhancedPaletteSubsystem::MakePlaceableItem(const FName& InCategory, const TInstancedStruct<FConfigPlaceableItem>& InConfigItem)
 {
-	FPaletteScopedTimeLogger ScopedLog(FPaletteScopedTimeLogger::START_END, TEXT("Populating category items"), ELogVerbosity::Verbose);
+	if (!InConfigItem.IsValid() || !InConfigItem.Get<FConfigPlaceableItem>().IsValidData())
+		return nullptr;
 
-	FPlacementModeModuleAccess& Access = GetModuleRef();
+	EPP_TRACE_SCOPE_TEXT(*InConfigItem.GetScriptStruct()->GetName());
+	TSharedPtr<FPlaceableItem> Item = InConfigItem.Get<FConfigPlaceableItem>().MakeItem();
+	if (Item.IsValid())
+	{
+		UE_LOG(LogEnhancedPalette, Verbose, TEXT("Register Placement Item: Category=%s Name=%s Factory=%s ObjectData=%s"),
+			*InCategory.ToString(),
+			*Item->GetNativeFName().ToString(),
+			*GetPathNameSafe(Item->AssetFactory.GetObject()),
+			*Item->AssetData.ToSoftObjectPath().ToString()
+		);
+	}
+	return Item;
+}
 
-	//Access->RegenerateItemsForCategory(FBuiltInPlacementCategories::RecentlyPlaced());
-	//Access->RegenerateItemsForCategory(FBuiltInPlacementCategories::Volumes());
-	//Access->RegenerateItemsForCategory(FBuiltInPlacementCategories::AllClasses());
-	//Access->RegenerateItemsForCategory(FBuiltInPlacementCategories::Favorites());
-	bool bChanged = false;
+void UEnhancedPaletteSubsystem::ApplyExternalCategoryDeltas()
+{
+	EPP_TRACE_SCOPE(EnhancedPalette_ApplyExternalCategoryDeltas);
+	FPaletteScopedTimeLogger ScopedLog(FPaletteScopedTimeLogger::END, TEXT("ApplyExternalCategoryDeltas"), ELogVerbosity::Verbose);
+
+	FPlacementModeModuleAccess& Access = GetModuleRef();
 
 	for (const TSharedPtr<FManagedCategory>& Ptr : ManagedCategories)
 	{
-		if (Ptr->bDirtyContent)
-		{
-			FPaletteScopedTimeLogger ScopeForCategory(FPaletteScopedTimeLogger::START_END, Ptr->UniqueId.ToString(), ELogVerbosity::Verbose);
-
-			Ptr->bDirtyContent = false;
-			bChanged = true;
+		if (!Ptr->HasFlag(EManagedCategoryFlags::Type_External))
+			continue;
 
-			// purge all existing registrations within category
-			for (const FPlacementModeID& ManagedId : Ptr->ManagedIds)
-			{
-				Access->UnregisterPlaceableItem(ManagedId);
-			}
-			Ptr->ManagedIds.Empty();
+		FExternalCategory& Category = static_cast<FExternalCategory&>(*Ptr);
+		// full populate is pending and will pick up everything
+		if (!Category.bRegistered || Category.bDirtyContent || !Category.HasPendingDelta())
+			continue;
 
-			TArray<TInstancedStruct<FConfigPlaceableItem>> Result;
-			Ptr->GatherPlaceableItems(this, Result);
+		const double CategoryStart = FPlatformTime::Seconds();
 
-			TArray<FName> KnownInternalNames;
-			KnownInternalNames.Reserve(Result.Num());
+		if (Category.PendingRemove.Num())
+		{
+			Access.UnregisterPlaceableItems(Category.PendingRemove, false);
+			SearchIndex->RemoveItems(Category.PendingRemove);
 
-			for (const TInstancedStruct<FConfigPlaceableItem>& ConfigItem : Result)
+			TSet<FGuid> Removed;
+			Removed.Reserve(Category.PendingRemove.Num());
+			for (const FPlacementModeID& Id : Category.PendingRemove)
 			{
-				if (!ConfigItem.IsValid() || !ConfigItem.Get<FConfigPlaceableItem>().IsValidData())
-					continue;
+				Removed.Add(Id.UniqueId);
+				Category.ItemHashes.Remove(Id.UniqueId);
+			}
+			Category.ManagedIds.RemoveAll([&Removed](const FPlacementModeID& Id) { return Removed.Contains(Id.UniqueId); });
+			Category.PendingRemove.Reset();
+		}
 
-				if (TSharedPtr<FPlaceableItem> Item = ConfigItem.Get<FConfigPlaceableItem>().MakeItem())
+		if (Category.PendingAppend.Num())
+		{
+			TArray<TSharedRef<FPlaceableItem>> Items;
+			TArray<FGuid> Handles;
+			TArray<uint64> Hashes;
+			Items.Reserve(Category.PendingAppend.Num());
+			Handles.Reserve(Category.PendingAppend.Num());
+			Hashes.Reserve(Category.PendingAppend.Num());
+
+			for (const FGuid& Handle : Category.PendingAppend)
+			{
+				const TInstancedStruct<FConfigPlaceableItem>* ConfigItem = Category.ExternalItems.Find(Handle);
+				TSharedPtr<FPlaceableItem> Item = ConfigItem ? MakePlaceableItem(Category.UniqueId, *ConfigItem) : nullptr;
+				if (Item.IsValid())
 				{
-					UE_LOG(LogEnhancedPalette, Verbose, TEXT("Register Placement Item: Category=%s Name=%s Factory=%s ObjectData=%s"),
-						*Ptr->UniqueId.ToString(),
-						*Item->GetNativeFName().ToString(),
-						*GetPathNameSafe(Item->AssetFactory.GetObject()),
-						*Item->AssetData.ToSoftObjectPath().ToString()
-					);
-
-					if (KnownInternalNames.Contains(Item->GetNativeFName()))
-					{
-						UE_LOG(LogEnhancedPalette, Warning, TEXT("Duplicating native name found [Category=%s Name=%s] it may affect favorites list"),
-							*Ptr->UniqueId.ToString(),
-							*Item->GetNativeFName().ToString());
-						// continue;
-					}
+					Items.Add(Item.ToSharedRef());
+					Handles.Add(Handle);
+					Hashes.Add(FPaletteContentSnapshot::HashItem(*ConfigItem));
+				}
+			}
+			Category.PendingAppend.Reset();
 
-					TOptional<FPlacementModeID> Id = Access->RegisterPlaceableItem(Ptr->UniqueId, Item.ToSharedRef());
-					if (Id.IsSet())
-					{
-						KnownInternalNames.Add(Item->GetNativeFName());
-						Ptr->ManagedIds.Add(Id.GetValue());
-					}
-					else
+			TArray<FPlacementModeID> Ids;
+			if (Access.RegisterPlaceableItems(Category.UniqueId, Items, Ids, false))
+			{
+				for (int32 Index = 0; Index < Ids.Num(); ++Index)
+				{
+					Category.RegisteredHandles.Add(Handles[Index], Ids[Index]);
+					SearchIndex->AddItem(Ids[Index], *Items[Index]);
+					if (Hashes[Index])
 					{
-						UE_LOG(LogEnhancedPalette, Warning, TEXT("Register Placement Item: Failed"));
+						Category.ItemHashes.Add(Ids[Index].UniqueId, Hashes[Index]);
 					}
-
 				}
+				Category.ManagedIds.Append(Ids);
 			}
-
-			Access.NotifyCategoryRefreshed(Ptr->UniqueId);
 		}
+
+		Access.NotifyCategoryRefreshed(Category.UniqueId);
+		RequestToolbarContentRefresh(Category.UniqueId);
+
+		BroadcastCategoryPopulated(Category, FPlatformTime::Seconds() - CategoryStart);
 	}
+}
 
-	if (bChanged)
+void UEnhancedPaletteSubsystem::BroadcastCategoryPopulated(const FManagedCategory& Category, double Seconds)
+{
+	if (OnCategoryPopulatedPrivate.IsBound())
 	{
-		RequestToolbarRefresh();
-		RequestToolbarContentRefresh();
+		FPaletteCategoryPopulateResult Result;
+		Result.CategoryId = Category.UniqueId;
+		Result.NumItems = Category.ManagedIds.Num();
+		Result.Seconds = static_cast<float>(Seconds);
+		OnCategoryPopulatedPrivate.Broadcast(Result);
 	}
 }
 
-bool UEnhancedPaletteSubsystem::CreateExternalCategory(const FStaticPlacementCategoryInfo& CreationInfo)
+bool UEnhancedPaletteSubsystem::IsPopulateIdle(TConstArrayView<FName> InCategories) const
 {
-	if (FindManagedCategory(CreationInfo.UniqueId) != nullptr)
+	if (bPendingAssetLoad || bRequireDiscover || bRequireApplyExternalDeltas)
 	{
-		UE_LOG(LogEnhancedPalette, Warning, TEXT("Failed to create external category: already registered"))
 		return false;
 	}
-
-	auto Category = MakeShared<FExternalCategory>(CreationInfo.UniqueId);
-	Category->Data = CreationInfo;
-	ManagedCategories.Add(MoveTemp(Category));
-
-	// would need update as new discovery was made
-	RequestDiscover();
+	// pending populate of other categories does not matter for listed ones
+	if (InCategories.IsEmpty() && bRequirePopulate)
+	{
+		return false;
+	}
+	for (const TSharedPtr<FManagedCategory>& Ptr : ManagedCategories)
+	{
+		if (Ptr->bDirtyContent && (InCategories.IsEmpty() || InCategories.Contains(Ptr->UniqueId)))
+		{
+			return false;
+		}
+	}
 	return true;
 }
 
-bool UEnhancedPaletteSubsystem::RemoveExternalCategory(const FName& UniqueId)
+bool UEnhancedPaletteSubsystem::UpdatePaletteShown()
 {
-	auto Found = FindManagedCategory(UniqueId);
-	if (Found && Found->HasFlag(EManagedCategoryFlags::Type_External))
+	// tab lookup is not free, poll it at a modest rate
+	const double Now = FPlatformTime::Seconds();
+	if (Now - LastPaletteShownPollTime < 0.25)
 	{
-		static_cast<FExternalCategory&>(*Found).bPendingKill = true;
-		RequestDiscover();
-		return true;
+		return bPaletteShown;
 	}
-	return false;
-}
+	LastPaletteShownPollTime = Now;
 
-bool UEnhancedPaletteSubsystem::AddExternalCategoryItem(const FName& UniqueId, TInstancedStruct<FConfigPlaceableItem> Item)
-{
-	auto Found = FindManagedCategory(UniqueId);
-	if (Found && Found->HasFlag(EManagedCategoryFlags::Type_External))
+	const bool bWasShown = bPaletteShown;
+	bPaletteShown = GetModuleRef().IsToolWidgetShown();
+
+	if (bPaletteShown)
 	{
-		static_cast<FExternalCategory&>(*Found).Data.Items.Add(MoveTemp(Item));
+		// recency of categories shown to user, used to prioritize populate
+		const FName Active = GetModuleRef().TryGetActiveCategory();
+		if (!Active.IsNone())
+		{
+			CategoryLastShownTime.Add(Active, Now);
+		}
+	}
+
+	if (bPaletteShown && !bWasShown && bPopulateDeferred)
+	{
+		UE_LOG(LogEnhancedPalette, Verbose, TEXT("Placement browser shown, applying postponed populate"));
+		bPopulateDeferred = false;
 		RequestPopulate();
-		return true;
 	}
-	return false;
+	return bPaletteShown;
 }
 
-void UEnhancedPaletteSubsystem::Deinitialize()
+bool UEnhancedPaletteSubsystem::TryPopulateCategoryItems(bool bDeferHidden)
 {
-	UE_LOG(LogEnhancedPalette, Verbose, TEXT("DeInitializing subsystem"));
+	EPP_TRACE_SCOPE(EnhancedPalette_Populate);
+	SCOPE_CYCLE_COUNTER(STAT_EnhancedPalette_Populate);
+	FPaletteScopedTimeLogger ScopedLog(FPaletteScopedTimeLogger::START_END, TEXT("Populating category items"), ELogVerbosity::Verbose);
 
-	bSubsystemReady = false;
+	//Access->RegenerateItemsForCategory(FBuiltInPlacementCategories::RecentlyPlaced());
+	//Access->RegenerateItemsForCategory(FBuiltInPlacementCategories::Volumes());
+	//Access->RegenerateItemsForCategory(FBuiltInPlacementCategories::AllClasses());
+	//Access->RegenerateItemsForCategory(FBuiltInPlacementCategories::Favorites());
 
-	ExternalChangeTracker->UnregisterTrackers(this);
-	ExternalChangeTracker.Reset();
+	TArray<FManagedCategory*> Queue;
+	for (const TSharedPtr<FManagedCategory>& Ptr : ManagedCategories)
+	{
+		if (!Ptr->bDirtyContent)
+			continue;
 
-	FModuleManager::Get().OnModulesChanged().RemoveAll(this);
+		if (bDeferHidden && Ptr->bPopulated && !Ptr->HasFlag(EManagedCategoryFlags::Behavior_KeepUpdatedWhileHidden))
+		{
+			// keep dirty until placement browser is shown
+			bPopulateDeferred = true;
+			continue;
+		}
 
+		Queue.Add(Ptr.Get());
+	}
+
+	SortPopulateQueue(Queue);
+	RunSharedAssetEnumeration(Queue);
+
+	const double Budget = GetDefault<UEnhancedPaletteSettings>()->PopulateFrameBudgetMs / 1000.0;
+	const double Start = FPlatformTime::Seconds();
+
+	for (int32 Index = 0; Index < Queue.Num(); ++Index)
 	{
-		FPlacementModeModuleAccess& ModuleRef = GetModuleRef();
-		for (const TSharedPtr<FManagedCategory>& Ptr : ManagedCategories)
+		// at least one category per frame, the most important one always makes progress
+		if (Index > 0 && Budget > 0 && FPlatformTime::Seconds() - Start > Budget)
 		{
-			Ptr->Unregister(this, ModuleRef);
+			UE_LOG(LogEnhancedPalette, Verbose, TEXT("Populate budget exceeded, %d categories postponed to next frame"), Queue.Num() - Index);
+			++Counters.PostponedPopulates;
+			return false;
 		}
-	}
 
-	ManagedCategories.Empty();
-	ModuleAccessPrivate.Reset();
+		PopulateCategory(*Queue[Index]);
+	}
+	return true;
 }
 
-void UEnhancedPaletteSubsystem::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+void UEnhancedPaletteSubsystem::SortPopulateQueue(TArray<FManagedCategory*>& Queue)
 {
-	Super::AddReferencedObjects(InThis, Collector);
+	if (Queue.Num() < 2)
+		return;
 
-	UEnhancedPaletteSubsystem* Self = CastChecked<UEnhancedPaletteSubsystem>(InThis);
-	for (const TSharedPtr<FManagedCategory>& Ptr : Self->ManagedCategories)
+	// category shown in palette goes first, then recently shown ones, then the rest in original order
+	const FName Active = bPaletteShown ? GetModuleRef().TryGetActiveCategory() : NAME_None;
+
+	TMap<const FManagedCategory*, double> Priority;
+	Priority.Reserve(Queue.Num());
+	for (const FManagedCategory* Category : Queue)
 	{
-		Ptr->AddReferencedObjects(Collector, Self);
+		const double* LastShown = CategoryLastShownTime.Find(Category->UniqueId);
+		Priority.Add(Category, Category->UniqueId == Active ? TNumericLimits<double>::Max() : (LastShown ? *LastShown : -1.0));
 	}
+
+	Algo::StableSort(Queue, [&Priority](const FManagedCategory* A, const FManagedCategory* B)
+	{
+		return Priority.FindChecked(A) > Priority.FindChecked(B);
+	});
 }
 
-void UEnhancedPaletteSubsystem::ApplyEngineCategorySettings()
+void UEnhancedPaletteSubsystem::PopulateCategory(FManagedCategory& Category)
 {
-	FPaletteScopedTimeLogger ScopedLog(FPaletteScopedTimeLogger::END, TEXT("ApplyEngineCategorySettings"), ELogVerbosity::Verbose);
+	EPP_TRACE_SCOPE_TEXT(*Category.UniqueId.ToString());
+	TGuardValue<FName> CategoryScope(WorkingCategory, Category.UniqueId);
 
-	auto& ModuleRef = GetModuleRef();
-	auto* Settings = GetMutableDefault<UEnhancedPaletteSettings>();
+	FPlacementModeModuleAccess& Access = GetModuleRef();
 
-	// Phase 1: apply sort order changes
+	FPaletteScopedTimeLogger ScopeForCategory(FPaletteScopedTimeLogger::START_END, Category.UniqueId.ToString(), ELogVerbosity::Verbose);
+	const double CategoryStart = FPlatformTime::Seconds();
 
-	for (const FStandardPlacementCategoryInfo& Pair : Settings->EngineCategories)
+	Category.bDirtyContent = false;
+	const uint32 Generation = Category.GetGeneration();
+
+	if (Category.bSharedEnumerationDone && Category.SharedEnumerationGeneration != Generation)
 	{
-		if (auto* Category = const_cast<FPlacementCategoryInfo*>(ModuleRef->GetRegisteredPlacementCategory(Pair.UniqueId)))
-		{
-			Category->SortOrder = Pair.Order;
-			// todo: here can possibly change data in engine categories
-		}
+		// changed after shared enumeration of this populate pass, enumerate again for current state
+		FManagedCategory* Self = &Category;
+		RunSharedAssetEnumeration(MakeArrayView(&Self, 1));
 	}
 
-	// Phase 2: apply visibility changes based on permission list
-
-	const FName OWNER_ID = UEnhancedPaletteSubsystem::StaticClass()->GetFName();
-
-	auto PermListAccess = StaticCastSharedRef<FPermissionListAccess>(ModuleRef->GetCategoryPermissionList());
-
+	TArray<TInstancedStruct<FConfigPlaceableItem>> Result;
+	const FName MapName = Category.HasFlag(EManagedCategoryFlags::DynamicTrait_World) ? GetEditorMapName() : NAME_None;
+	bool bStoreInWorldCache = false;
+	if (Category.HasFlag(EManagedCategoryFlags::DynamicTrait_World))
 	{
-		TGuardValue<bool> Guard(PermListAccess->bSuppressOnFilterChanged, true);
-		PermListAccess->UnregisterOwner(OWNER_ID);
-		for (const FName& KnownCategory : Settings->CachedKnownCategories)
+		WorldCache->SetCapacity(GetDefault<UEnhancedPaletteSettings>()->WorldCacheSize);
+
+		const FPaletteWorldCache::FItems* Cached = Category.bRestoreFromWorldCache ? WorldCache->Find(MapName, Category.UniqueId) : nullptr;
+		if (Cached)
 		{
-			PermListAccess->RemoveDenyListItem(OWNER_ID, KnownCategory);
+			UE_LOG(LogEnhancedPalette, Verbose, TEXT("Restoring %s content for map %s from cache"), *Category.UniqueId.ToString(), *MapName.ToString());
+			Result = *Cached;
 		}
-		for (const FStandardPlacementCategoryInfo& Pair : Settings->EngineCategories)
+		else
 		{
-			if (!Pair.bVisible)
-			{
-				PermListAccess->AddDenyListItem(OWNER_ID, Pair.UniqueId);
-			}
+			EPP_TRACE_SCOPE(EnhancedPalette_Gather);
+			SCOPE_CYCLE_COUNTER(STAT_EnhancedPalette_Gather);
+			Category.GatherPlaceableItems(this, Result);
+			bStoreInWorldCache = true;
 		}
 	}
+	else
+	{
+		EPP_TRACE_SCOPE(EnhancedPalette_Gather);
+		SCOPE_CYCLE_COUNTER(STAT_EnhancedPalette_Gather);
+		Category.GatherPlaceableItems(this, Result);
+	}
+	const bool bGathered = !Category.HasFlag(EManagedCategoryFlags::DynamicTrait_World) || bStoreInWorldCache;
+	const double GatherTime = FPlatformTime::Seconds() - CategoryStart;
+	Category.bRestoreFromWorldCache = false;
+	Category.bSharedEnumerationDone = false;
 
-	PermListAccess->NotifyChanged();
+	if (Category.GetGeneration() != Generation)
+	{
+		// dirtied again while gathering, results are cancelled or stale and would only be undone by next populate
+		++Counters.CancelledGathers;
+		if (++Category.DiscardedGathers <= MaxDiscardedGathers)
+		{
+			UE_LOG(LogEnhancedPalette, Verbose, TEXT("Discarding superseded gather of %s"), *Category.UniqueId.ToString());
+			Category.bDirtyContent = true;
+			RequestPopulate();
+			return;
+		}
 
-	RequestToolbarRefresh();
-}
+		// changes during every gather, keep last registered content and stop regathering until dirtied again
+		UE_LOG(LogEnhancedPalette, Warning, TEXT("Category %s changed during %d gathers in a row, keeping previous content"),
+			*Category.UniqueId.ToString(), Category.DiscardedGathers);
+		Category.DiscardedGathers = 0;
+		Category.bDirtyContent = false;
 
-void UEnhancedPaletteSubsystem::ApplyManagedCategorySettings()
-{
+		if (Category.HasFlag(EManagedCategoryFlags::DynamicTrait_Tracking) && !Category.bThrottled)
+		{
+			Category.bThrottled = true;
+			++Counters.ThrottledCategories;
+
+			NotifyCategoryThrottled(FText::Format(
+				NSLOCTEXT("EnhancedPalette", "SupersededThrottled", "Palette category {0} changed during each of its last {1} gathers. Change tracking of it is paused."),
+				FText::FromName(Category.UniqueId), FText::AsNumber(MaxDiscardedGathers + 1)));
+		}
+		return;
+	}
+	Category.DiscardedGathers = 0;
+	Category.bPopulated = true;
+
+	if (bGathered)
+	{
+		CheckGatherBudget(Category, GatherTime, Result.Num());
+	}
+
+	if (bStoreInWorldCache)
+	{
+		WorldCache->Store(MapName, Category.UniqueId, Result);
+	}
+
+	// previous registrations by descriptor hash, unchanged descriptors keep their registration
+	TMultiMap<uint64, int32> PreviousByHash;
+	PreviousByHash.Reserve(Category.ManagedIds.Num());
+	for (int32 Index = 0; Index < Category.ManagedIds.Num(); ++Index)
+	{
+		if (const uint64* Hash = Category.ItemHashes.Find(Category.ManagedIds[Index].UniqueId))
+		{
+			PreviousByHash.Add(*Hash, Index);
+		}
+	}
+	TBitArray<> KeptPrevious(false, Category.ManagedIds.Num());
+
+	TSet<FName> KnownInternalNames;
+	KnownInternalNames.Reserve(Result.Num());
+
+	// resulting registrations in gather order
+	TArray<FPlacementModeID> NewIds;
+	NewIds.Reserve(Result.Num());
+	TArray<uint64> NewHashes;
+	NewHashes.Reserve(Result.Num());
+	TArray<int32> SourceIndices;
+	SourceIndices.Reserve(Result.Num());
+
+	// items that need registration and their positions within resulting registrations
+	TArray<TSharedRef<FPlaceableItem>> Items;
+	TArray<int32> ItemSlots;
+
+	for (int32 SourceIndex = 0; SourceIndex < Result.Num(); ++SourceIndex)
+	{
+		const uint64 Hash = FPaletteContentSnapshot::HashItem(Result[SourceIndex]);
+		if (const int32* Previous = Hash ? PreviousByHash.Find(Hash) : nullptr)
+		{
+			const int32 PreviousIndex = *Previous;
+			PreviousByHash.RemoveSingle(Hash, PreviousIndex);
+			KeptPrevious[PreviousIndex] = true;
+
+			NewIds.Add(Category.ManagedIds[PreviousIndex]);
+			NewHashes.Add(Hash);
+			SourceIndices.Add(SourceIndex);
+			continue;
+		}
+
+		if (TSharedPtr<FPlaceableItem> Item = MakePlaceableItem(Category.UniqueId, Result[SourceIndex]))
+		{
+			if (KnownInternalNames.Contains(Item->GetNativeFName()))
+			{
+				UE_LOG(LogEnhancedPalette, Warning, TEXT("Duplicating native name found [Category=%s Name=%s] it may affect favorites list"),
+					*Category.UniqueId.ToString(),
+					*Item->GetNativeFName().ToString());
+				// continue;
+			}
+
+			KnownInternalNames.Add(Item->GetNativeFName());
+			Items.Add(Item.ToSharedRef());
+			ItemSlots.Add(NewIds.Num());
+
+			NewIds.AddDefaulted();
+			NewHashes.Add(Hash);
+			SourceIndices.Add(SourceIndex);
+		}
+	}
+
+	// purge registrations of descriptors that are gone or changed, refresh is notified once below
+	TArray<FPlacementModeID> RemovedIds;
+	for (int32 Index = 0; Index < Category.ManagedIds.Num(); ++Index)
+	{
+		if (!KeptPrevious[Index])
+		{
+			RemovedIds.Add(Category.ManagedIds[Index]);
+		}
+	}
+	Access.UnregisterPlaceableItems(RemovedIds, false);
+	SearchIndex->RemoveItems(RemovedIds);
+
+	TArray<FPlacementModeID> RegisteredIds;
+	if (Items.Num() && Access.RegisterPlaceableItems(Category.UniqueId, Items, RegisteredIds, false))
+	{
+		for (int32 Index = 0; Index < Items.Num(); ++Index)
+		{
+			NewIds[ItemSlots[Index]] = RegisteredIds[Index];
+			SearchIndex->AddItem(RegisteredIds[Index], *Items[Index]);
+		}
+	}
+	else if (Items.Num())
+	{
+		UE_LOG(LogEnhancedPalette, Warning, TEXT("Register Placement Items: Failed for category %s"), *Category.UniqueId.ToString());
+	}
+
+	Category.ManagedIds.Reset(NewIds.Num());
+	Category.ItemHashes.Reset();
+	TArray<int32> RegisteredSourceIndices;
+	RegisteredSourceIndices.Reserve(NewIds.Num());
+	for (int32 Index = 0; Index < NewIds.Num(); ++Index)
+	{
+		// slots of items that failed to register stay invalid
+		if (NewIds[Index].UniqueId.IsValid())
+		{
+			Category.ManagedIds.Add(NewIds[Index]);
+			RegisteredSourceIndices.Add(SourceIndices[Index]);
+			if (NewHashes[Index])
+			{
+				Category.ItemHashes.Add(NewIds[Index].UniqueId, NewHashes[Index]);
+			}
+		}
+	}
+	Category.OnItemsRegistered(RegisteredSourceIndices, Category.ManagedIds);
+
+	Counters.KeptItemRegistrations += NewIds.Num() - Items.Num();
+
+	if (RemovedIds.Num() || Items.Num())
+	{
+		Access.NotifyCategoryRefreshed(Category.UniqueId);
+		// category set did not change, only its content needs refresh if shown
+		RequestToolbarContentRefresh(Category.UniqueId);
+
+		SaveContentSnapshot(Category, Result);
+	}
+
+	BroadcastCategoryPopulated(Category, FPlatformTime::Seconds() - CategoryStart);
+}
+
+void UEnhancedPaletteSubsystem::RunSharedAssetEnumeration(TConstArrayView<FManagedCategory*> InCategories)
+{
+	EPP_TRACE_SCOPE(EnhancedPalette_SharedEnumeration);
+
+	const FName MapName = GetEditorMapName();
+
+	FPaletteSharedEnumeration Enumeration;
+	TArray<FManagedCategory*, TInlineAllocator<16>> Clients;
+
+	for (FManagedCategory* Category : InCategories)
+	{
+		if (Category->bSharedEnumerationDone)
+		{
+			// categories postponed by populate budget already received their assets
+			if (Category->SharedEnumerationGeneration == Category->GetGeneration())
+				continue;
+			// category changed since, assets it received predate the change
+			Category->DiscardSharedEnumeration();
+			Category->bSharedEnumerationDone = false;
+		}
+		// restored from cache without gathering
+		if (Category->bRestoreFromWorldCache && Category->HasFlag(EManagedCategoryFlags::DynamicTrait_World) && WorldCache->Contains(MapName, Category->UniqueId))
+			continue;
+
+		FARFilter Filter;
+		if (Category->BeginSharedEnumeration(Filter))
+		{
+			Enumeration.AddClient(Filter);
+			Clients.Add(Category);
+		}
+	}
+
+	if (Clients.Num() == 0)
+		return;
+
+	{
+		FPaletteScopedTimeLogger ScopedLog(FPaletteScopedTimeLogger::END, FString::Printf(TEXT("Shared asset enumeration for %d categories"), Clients.Num()), ELogVerbosity::Verbose);
+
+		Counters.SharedEnumerations += Enumeration.Run([&Clients](int32 ClientIndex, const FAssetData& Asset)
+		{
+			Clients[ClientIndex]->ReceiveSharedAsset(Asset);
+		});
+		Counters.SharedEnumerationClients += Clients.Num();
+	}
+
+	for (FManagedCategory* Client : Clients)
+	{
+		Client->EndSharedEnumeration();
+		Client->bSharedEnumerationDone = true;
+		Client->SharedEnumerationGeneration = Client->GetGeneration();
+	}
+}
+
+void UEnhancedPaletteSubsystem::CheckGatherBudget(FManagedCategory& Category, double Seconds, int32 NumItems)
+{
+	const FManagedCategoryBudget Budget = Category.GetBudget();
+	const bool bOverTime = Budget.GatherSeconds > 0 && Seconds > Budget.GatherSeconds;
+	const bool bOverItems = Budget.MaxItems > 0 && NumItems > Budget.MaxItems;
+	if (!bOverTime && !bOverItems)
+	{
+		Category.GatherViolations = 0;
+		return;
+	}
+
+	++Category.GatherViolations;
+	UE_LOG(LogEnhancedPalette, Warning, TEXT("Category %s exceeded gather budget: %.1f ms, %d items (%d times in a row)"),
+		*Category.UniqueId.ToString(), Seconds * 1000.0, NumItems, Category.GatherViolations);
+
+	const int32 Threshold = GetDefault<UEnhancedPaletteSettings>()->ThrottleAfterViolations;
+	if (Threshold <= 0 || Category.GatherViolations < Threshold || Category.bThrottled || !Category.HasFlag(EManagedCategoryFlags::DynamicTrait_Tracking))
+		return;
+
+	Category.bThrottled = true;
+	++Counters.ThrottledCategories;
+
+	NotifyCategoryThrottled(FText::Format(
+		NSLOCTEXT("EnhancedPalette", "GatherThrottled", "Palette category {0} repeatedly exceeded its gather budget ({1} ms, {2} items). Change tracking of it is paused."),
+		FText::FromName(Category.UniqueId), FText::AsNumber(FMath::RoundToInt(Seconds * 1000.0)), FText::AsNumber(NumItems)));
+}
+
+void UEnhancedPaletteSubsystem::CheckTickBudget(FManagedCategory& Category, double Seconds)
+{
+	const FManagedCategoryBudget Budget = Category.GetBudget();
+	if (Budget.TickSeconds <= 0 || Seconds <= Budget.TickSeconds)
+	{
+		Category.TickViolations = 0;
+		return;
+	}
+
+	++Category.TickViolations;
+	UE_LOG(LogEnhancedPalette, Warning, TEXT("Category %s exceeded update budget: %.1f ms (%d times in a row)"),
+		*Category.UniqueId.ToString(), Seconds * 1000.0, Category.TickViolations);
+
+	const int32 Threshold = GetDefault<UEnhancedPaletteSettings>()->ThrottleAfterViolations;
+	float NewInterval = 0.f;
+	if (Threshold <= 0 || Category.TickViolations < Threshold || !Category.RaiseTickInterval(NewInterval))
+		return;
+
+	// measured again at raised interval
+	Category.TickViolations = 0;
+	++Counters.ThrottledCategories;
+
+	NotifyCategoryThrottled(FText::Format(
+		NSLOCTEXT("EnhancedPalette", "TickThrottled", "Palette category {0} repeatedly exceeded its update budget ({1} ms). Update interval raised to {2} s."),
+		FText::FromName(Category.UniqueId), FText::AsNumber(FMath::RoundToInt(Seconds * 1000.0)), FText::AsNumber(NewInterval)));
+}
+
+void UEnhancedPaletteSubsystem::NotifyCategoryThrottled(const FText& Message)
+{
+	UE_LOG(LogEnhancedPalette, Warning, TEXT("%s"), *Message.ToString());
+
+	// single notification on screen, latest message replaces previous one
+	if (TSharedPtr<SNotificationItem> Existing = NotificationItemPtr.Pin())
+	{
+		Existing->Fadeout();
+	}
+
+	FNotificationInfo Info(Message);
+	Info.bFireAndForget = true;
+	Info.ExpireDuration = 8.f;
+	Info.ButtonDetails.Add(FNotificationButtonInfo(
+		NSLOCTEXT("EnhancedPalette", "ResumeThrottled", "Resume"),
+		NSLOCTEXT("EnhancedPalette", "ResumeThrottledTooltip", "Resume change tracking and restore update intervals of throttled palette categories"),
+		FSimpleDelegate::CreateUObject(this, &ThisClass::ResumeThrottledCategories)));
+	NotificationItemPtr = FSlateNotificationManager::Get().AddNotification(Info);
+}
+
+void UEnhancedPaletteSubsystem::ResumeThrottledCategories()
+{
+	for (const TSharedPtr<FManagedCategory>& Ptr : ManagedCategories)
+	{
+		if (Ptr->RestoreTickInterval())
+		{
+			UE_LOG(LogEnhancedPalette, Log, TEXT("Restoring update interval of %s"), *Ptr->UniqueId.ToString());
+			Ptr->TickViolations = 0;
+		}
+
+		if (Ptr->bThrottled)
+		{
+			UE_LOG(LogEnhancedPalette, Log, TEXT("Resuming change tracking of %s"), *Ptr->UniqueId.ToString());
+			Ptr->bThrottled = false;
+			Ptr->GatherViolations = 0;
+			// changes were missed while throttled
+			MarkCategoryDirty(Ptr->UniqueId, EManagedCategoryDirtyFlags::Content);
+		}
+	}
+
+	if (TSharedPtr<SNotificationItem> Existing = NotificationItemPtr.Pin())
+	{
+		Existing->Fadeout();
+	}
+	NotificationItemPtr.Reset();
+}
+
+void UEnhancedPaletteSubsystem::RestoreContentSnapshots()
+{
+	const UEnhancedPaletteSettings* Settings = GetDefault<UEnhancedPaletteSettings>();
+	if (!Settings->bEnableContentSnapshots)
+		return;
+
+	FPaletteScopedTimeLogger ScopedLog(FPaletteScopedTimeLogger::END, TEXT("Restoring content snapshots"), ELogVerbosity::Log);
+
+	TArray<FPaletteContentSnapshot> Snapshots;
+	FPaletteContentSnapshot::ReadAll(Snapshots);
+
+	TSet<FString> KnownSources;
+	for (const TSoftClassPtr<UEnhancedPaletteCategory>& Source : Settings->DynamicCategories)
+	{
+		KnownSources.Add(Source.ToString());
+	}
+
+	FPlacementModeModuleAccess& Access = GetModuleRef();
+	FScopedSelfMutation SelfMutation(this);
+
+	for (const FPaletteContentSnapshot& Snapshot : Snapshots)
+	{
+		// only categories that discovery would produce, asset scan results are unknown yet
+		if (!Settings->bEnableAssetCategoryDiscovery && !KnownSources.Contains(Snapshot.SourcePath))
+			continue;
+		if (RestoredCategories.Contains(Snapshot.UniqueId) || Access->GetRegisteredPlacementCategory(Snapshot.UniqueId))
+			continue;
+
+		FPlacementCategoryInfo Reg(
+			Snapshot.DisplayName,
+			FSimpleIconReference(Snapshot.IconCode).GetSlateIcon(),
+			Snapshot.UniqueId,
+			Snapshot.TagMetaData,
+			Snapshot.SortOrder,
+			Snapshot.bSortable
+		);
+#if UE_VERSION_NEWER_THAN_OR_EQUAL(5, 5, 0)
+		Reg.ShortDisplayName = Snapshot.ShortDisplayName;
+#endif
+		if (!Access->RegisterPlacementCategory(Reg))
+			continue;
+
+		TSharedPtr<FRestoredCategory> Restored = MakeShared<FRestoredCategory>();
+
+		TArray<TSharedRef<FPlaceableItem>> Items;
+		TArray<uint64> Hashes;
+		Items.Reserve(Snapshot.Items.Num());
+		Hashes.Reserve(Snapshot.Items.Num());
+		for (int32 Index = 0; Index < Snapshot.Items.Num(); ++Index)
+		{
+			// asset scan is likely in progress, items are made from asset data stored in snapshot
+			if (TSharedPtr<FPlaceableItem> Item = MakePlaceableItem(Snapshot.UniqueId, Snapshot.MakeRestoreItem(Index)))
+			{
+				Items.Add(Item.ToSharedRef());
+				// hash of gathered descriptor, so revalidation keeps unchanged registrations
+				Hashes.Add(FPaletteContentSnapshot::HashItem(Snapshot.Items[Index]));
+			}
+		}
+
+		if (const int32 NumSkipped = Snapshot.Items.Num() - Items.Num())
+		{
+			UE_LOG(LogEnhancedPalette, Log, TEXT("Restoring category %s skipped %d of %d snapshot items that could not be made"),
+				*Snapshot.UniqueId.ToString(), NumSkipped, Snapshot.Items.Num());
+		}
+
+		if (Access.RegisterPlaceableItems(Snapshot.UniqueId, Items, Restored->ManagedIds))
+		{
+			for (int32 Index = 0; Index < Items.Num(); ++Index)
+			{
+				SearchIndex->AddItem(Restored->ManagedIds[Index], *Items[Index]);
+				if (Hashes[Index])
+				{
+					Restored->ItemHashes.Add(Restored->ManagedIds[Index].UniqueId, Hashes[Index]);
+				}
+			}
+		}
+
+		UE_LOG(LogEnhancedPalette, Verbose, TEXT("Restored category %s with %d items from snapshot"), *Snapshot.UniqueId.ToString(), Restored->ManagedIds.Num());
+		RestoredCategories.Add(Snapshot.UniqueId, Restored);
+	}
+}
+
+bool UEnhancedPaletteSubsystem::AdoptRestoredCategory(FManagedCategory& Category)
+{
+	TSharedPtr<FRestoredCategory> Restored;
+	if (!RestoredCategories.RemoveAndCopyValue(Category.UniqueId, Restored))
+	{
+		return false;
+	}
+
+	UE_LOG(LogEnhancedPalette, Verbose, TEXT("Category %s adopted restored content, revalidating"), *Category.UniqueId.ToString());
+
+	Category.ManagedIds = MoveTemp(Restored->ManagedIds);
+	Category.ItemHashes = MoveTemp(Restored->ItemHashes);
+	return true;
+}
+
+bool UEnhancedPaletteSubsystem::DiscardRestoredCategories()
+{
+	if (RestoredCategories.IsEmpty())
+	{
+		return false;
+	}
+
+	FPlacementModeModuleAccess& Access = GetModuleRef();
+	for (const TPair<FName, TSharedPtr<FRestoredCategory>>& Pair : RestoredCategories)
+	{
+		UE_LOG(LogEnhancedPalette, Verbose, TEXT("Discover: removed restored category %s"), *Pair.Key.ToString());
+
+		SearchIndex->RemoveItems(Pair.Value->ManagedIds);
+		Access->UnregisterPlacementCategory(Pair.Key);
+		// source category is gone, its snapshot is of no use anymore
+		FPaletteContentSnapshot::Delete(Pair.Key);
+	}
+	RestoredCategories.Empty();
+	return true;
+}
+
+void UEnhancedPaletteSubsystem::SaveContentSnapshot(const FManagedCategory& Category, const TArray<TInstancedStruct<FConfigPlaceableItem>>& Items) const
+{
+	if (!GetDefault<UEnhancedPaletteSettings>()->bEnableContentSnapshots || !Category.HasFlag(EManagedCategoryFlags::Type_Asset))
+		return;
+
+	const FAssetDrivenCategory& AssetCategory = static_cast<const FAssetDrivenCategory&>(Category);
+	const UEnhancedPaletteCategory* DefaultInstance = AssetCategory.InstanceDefault;
+	if (!IsValid(DefaultInstance))
+		return;
+
+	FPaletteContentSnapshot Snapshot;
+	Snapshot.UniqueId = Category.UniqueId;
+	Snapshot.SourcePath = AssetCategory.Source.ToString();
+	Snapshot.DisplayName = DefaultInstance->GetDisplayName();
+	Snapshot.ShortDisplayName = DefaultInstance->GetShortDisplayName();
+	const FSlateIcon Icon = DefaultInstance->GetDisplayIcon();
+	Snapshot.IconCode = FSimpleIconReference(Icon.GetStyleSetName(), Icon.GetStyleName()).GetIconCode();
+	Snapshot.TagMetaData = DefaultInstance->GetTagMetaData();
+	Snapshot.SortOrder = DefaultInstance->GetSortOrder();
+	Snapshot.bSortable = DefaultInstance->IsSortable();
+	Snapshot.Items = Items;
+
+	TArray<uint8> Bytes;
+	if (Snapshot.Save(Bytes))
+	{
+		FPaletteContentSnapshot::WriteAsync(Category.UniqueId, MoveTemp(Bytes));
+	}
+	else
+	{
+		// content can not be persisted, do not restore outdated one
+		FPaletteContentSnapshot::Delete(Category.UniqueId);
+	}
+}
+
+void UEnhancedPaletteSubsystem::SearchPlaceableItems(const FString& InQuery, int32 MaxResults, TArray<FPaletteSearchResult>& OutResults)
+{
+	OutResults.Reset();
+	if (SearchIndex.IsValid())
+	{
+		const double Start = FPlatformTime::Seconds();
+		SearchIndex->Search(InQuery, MaxResults, OutResults);
+		const double Delta = FPlatformTime::Seconds() - Start;
+
+		++Counters.Searches;
+		if (Delta > 0.001)
+		{
+			++Counters.SlowSearches;
+			UE_LOG(LogEnhancedPalette, Verbose, TEXT("Slow search '%s' over %d items: %d results in %.3f ms"), *InQuery, SearchIndex->Num(), OutResults.Num(), Delta * 1000.0);
+		}
+	}
+}
+
+FPaletteSearchIndex& UEnhancedPaletteSubsystem::GetSearchIndex() const
+{
+	check(SearchIndex.IsValid());
+	return *SearchIndex;
+}
+
+FPaletteWorldIndex& UEnhancedPaletteSubsystem::GetWorldIndex() const
+{
+	check(WorldIndex.IsValid());
+	return *WorldIndex;
+}
+
+FPaletteTagIndex& UEnhancedPaletteSubsystem::GetTagIndex() const
+{
+	check(TagIndex.IsValid());
+	return *TagIndex;
+}
+
+bool UEnhancedPaletteSubsystem::CreateExternalCategory(const FStaticPlacementCategoryInfo& CreationInfo)
+{
+	return CreateExternalCategories(MakeArrayView(&CreationInfo, 1)) == 1;
+}
+
+int32 UEnhancedPaletteSubsystem::CreateExternalCategories(TConstArrayView<FStaticPlacementCategoryInfo> CreationInfos)
+{
+	int32 NumCreated = 0;
+	for (const FStaticPlacementCategoryInfo& CreationInfo : CreationInfos)
+	{
+		if (CreationInfo.UniqueId.IsNone())
+		{
+			UE_LOG(LogEnhancedPalette, Warning, TEXT("Failed to create external category: invalid (None) id"));
+			continue;
+		}
+		if (FindManagedCategory(CreationInfo.UniqueId) != nullptr)
+		{
+			UE_LOG(LogEnhancedPalette, Warning, TEXT("Failed to create external category %s: already registered"), *CreationInfo.UniqueId.ToString());
+			continue;
+		}
+
+		auto Category = MakeShared<FExternalCategory>(CreationInfo.UniqueId);
+		Category->Data = CreationInfo;
+		// items are tracked by handle, initial ones are registered with first populate
+		Category->Data.Items.Reset();
+		for (const TInstancedStruct<FConfigPlaceableItem>& Item : CreationInfo.Items)
+		{
+			Category->AppendItem(Item);
+		}
+		ManagedCategories.Add(MoveTemp(Category));
+		++NumCreated;
+	}
+
+	if (NumCreated)
+	{
+		// would need update as new discovery was made
+		RequestDiscover();
+	}
+	return NumCreated;
+}
+
+bool UEnhancedPaletteSubsystem::RemoveExternalCategory(const FName& UniqueId)
+{
+	auto Found = FindManagedCategory(UniqueId);
+	if (Found && Found->HasFlag(EManagedCategoryFlags::Type_External))
+	{
+		static_cast<FExternalCategory&>(*Found).bPendingKill = true;
+		RequestDiscover();
+		return true;
+	}
+	return false;
+}
+
+bool UEnhancedPaletteSubsystem::AddExternalCategoryItem(const FName& UniqueId, TInstancedStruct<FConfigPlaceableItem> Item)
+{
+	TArray<FGuid> Handles;
+	return AddExternalCategoryItems(UniqueId, MakeArrayView(&Item, 1), Handles);
+}
+
+bool UEnhancedPaletteSubsystem::AddExternalCategoryItems(const FName& UniqueId, TConstArrayView<TInstancedStruct<FConfigPlaceableItem>> Items, TArray<FGuid>& OutHandles)
+{
+	OutHandles.Reset();
+
+	auto Found = FindManagedCategory(UniqueId);
+	if (Found && Found->HasFlag(EManagedCategoryFlags::Type_External))
+	{
+		FExternalCategory& Category = static_cast<FExternalCategory&>(*Found);
+		Category.ExternalItems.Reserve(Category.ExternalItems.Num() + Items.Num());
+		OutHandles.Reserve(Items.Num());
+		for (const TInstancedStruct<FConfigPlaceableItem>& Item : Items)
+		{
+			OutHandles.Add(Category.AppendItem(Item));
+		}
+		// only appended items are registered
+		bRequireApplyExternalDeltas = true;
+		return true;
+	}
+	return false;
+}
+
+int32 UEnhancedPaletteSubsystem::RemoveExternalCategoryItems(const FName& UniqueId, TConstArrayView<FGuid> Handles)
+{
+	int32 NumRemoved = 0;
+
+	auto Found = FindManagedCategory(UniqueId);
+	if (Found && Found->HasFlag(EManagedCategoryFlags::Type_External))
+	{
+		FExternalCategory& Category = static_cast<FExternalCategory&>(*Found);
+		for (const FGuid& Handle : Handles)
+		{
+			NumRemoved += Category.RemoveItem(Handle) ? 1 : 0;
+		}
+		if (NumRemoved)
+		{
+			// only removed items are unregistered
+			bRequireApplyExternalDeltas = true;
+		}
+	}
+	return NumRemoved;
+}
+
+void UEnhancedPaletteSubsystem::OnSyncLoadPackage(const FString& InPackageName)
+{
+	// loads outside of palette work belong to someone else
+	if (!bInPaletteWork)
+		return;
+
+	++Counters.SyncLoads;
+	INC_DWORD_STAT(STAT_EnhancedPalette_SyncLoads);
+	TRACE_COUNTER_INCREMENT(EnhancedPalette_SyncLoads);
+
+	UE_LOG(LogEnhancedPalette, Verbose, TEXT("Synchronous load of %s during palette work (category %s)"), *InPackageName, *WorkingCategory.ToString());
+}
+
+void UEnhancedPaletteSubsystem::UpdateStats() const
+{
+#if STATS || COUNTERSTRACE_ENABLED
+	int32 NumItems = 0;
+	int32 NumDirty = 0;
+	for (const TSharedPtr<FManagedCategory>& Ptr : ManagedCategories)
+	{
+		NumItems += Ptr->ManagedIds.Num();
+		NumDirty += Ptr->bDirtyContent ? 1 : 0;
+	}
+
+	SET_DWORD_STAT(STAT_EnhancedPalette_ManagedCategories, ManagedCategories.Num());
+	SET_DWORD_STAT(STAT_EnhancedPalette_RegisteredItems, NumItems);
+	SET_DWORD_STAT(STAT_EnhancedPalette_DirtyCategories, NumDirty);
+
+	TRACE_COUNTER_SET(EnhancedPalette_ManagedCategories, ManagedCategories.Num());
+	TRACE_COUNTER_SET(EnhancedPalette_RegisteredItems, NumItems);
+	TRACE_COUNTER_SET(EnhancedPalette_DirtyCategories, NumDirty);
+#endif
+}
+
+void UEnhancedPaletteSubsystem::Deinitialize()
+{
+	UE_LOG(LogEnhancedPalette, Verbose, TEXT("DeInitializing subsystem"));
+
+	bSubsystemReady = false;
+
+	if (bRequireSettingsSave)
+	{
+		bRequireSettingsSave = false;
+		TrySaveSettings();
+	}
+
+	ExternalChangeTracker->UnregisterTrackers(this);
+	ExternalChangeTracker.Reset();
+
+	WorldIndex->Shutdown();
+	TagIndex->Shutdown();
+
+	FModuleManager::Get().OnModulesChanged().RemoveAll(this);
+	FCoreUObjectDelegates::OnSyncLoadPackage.RemoveAll(this);
+
+	{
+		FPlacementModeModuleAccess& ModuleRef = GetModuleRef();
+		ModuleRef.FlushPendingConfig(true);
+
+		// nothing to clean up in PM if everything is going down anyway
+		if (!IsEngineExitRequested())
+		{
+			FScopedSelfMutation SelfMutation(this);
+			for (const TSharedPtr<FManagedCategory>& Ptr : ManagedCategories)
+			{
+				Ptr->Unregister(this, ModuleRef);
+			}
+			for (const TPair<FName, TSharedPtr<FRestoredCategory>>& Pair : RestoredCategories)
+			{
+				ModuleRef->UnregisterPlacementCategory(Pair.Key);
+			}
+		}
+	}
+
+	ManagedCategories.Empty();
+	RestoredCategories.Empty();
+	ModuleAccessPrivate.Reset();
+	SearchIndex.Reset();
+	WorldIndex.Reset();
+	WorldCache.Reset();
+	TagIndex.Reset();
+}
+
+void UEnhancedPaletteSubsystem::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	Super::AddReferencedObjects(InThis, Collector);
+
+	UEnhancedPaletteSubsystem* Self = CastChecked<UEnhancedPaletteSubsystem>(InThis);
+	for (const TSharedPtr<FManagedCategory>& Ptr : Self->ManagedCategories)
+	{
+		Ptr->AddReferencedObjects(Collector, Self);
+	}
+}
+
+void UEnhancedPaletteSubsystem::ApplyEngineCategorySettings()
+{
+	EPP_TRACE_SCOPE(EnhancedPalette_ApplyEngineCategorySettings);
+	FPaletteScopedTimeLogger ScopedLog(FPaletteScopedTimeLogger::END, TEXT("ApplyEngineCategorySettings"), ELogVerbosity::Verbose);
+
+	auto& ModuleRef = GetModuleRef();
+	auto* Settings = GetMutableDefault<UEnhancedPaletteSettings>();
+
+	const FName OWNER_ID = UEnhancedPaletteSubsystem::StaticClass()->GetFName();
+
+	auto PermListAccess = StaticCastSharedRef<FPermissionListAccess>(ModuleRef->GetCategoryPermissionList());
+
+	bool bOrderChanged = false;
+	bool bVisibilityChanged = false;
+
+	++Counters.EngineCategoryApplies;
+
+	// permission list change notifies about category list change
+	FScopedSelfMutation SelfMutation(this);
+
+	{
+		TGuardValue<bool> Guard(PermListAccess->bSuppressOnFilterChanged, true);
+
+		TSet<FName> Seen;
+		Seen.Reserve(Settings->EngineCategories.Num());
+
+		for (const FStandardPlacementCategoryInfo& Pair : Settings->EngineCategories)
+		{
+			Seen.Add(Pair.UniqueId);
+
+			// Phase 1: apply sort order changes against live category data
+			if (auto* Category = const_cast<FPlacementCategoryInfo*>(ModuleRef->GetRegisteredPlacementCategory(Pair.UniqueId)))
+			{
+				if (Category->SortOrder != Pair.Order)
+				{
+					Category->SortOrder = Pair.Order;
+					bOrderChanged = true;
+				}
+				// todo: here can possibly change data in engine categories
+			}
+
+			// Phase 2: apply visibility changes against last applied state of permission list
+			const FStandardPlacementCategoryInfo* Applied = AppliedEngineCategories.Find(Pair.UniqueId);
+			const bool bWasVisible = Applied ? Applied->bVisible : true;
+			if (bWasVisible != Pair.bVisible)
+			{
+				if (Pair.bVisible)
+				{
+					PermListAccess->RemoveDenyListItem(OWNER_ID, Pair.UniqueId);
+				}
+				else
+				{
+					PermListAccess->AddDenyListItem(OWNER_ID, Pair.UniqueId);
+				}
+				bVisibilityChanged = true;
+			}
+
+			AppliedEngineCategories.Add(Pair.UniqueId, Pair);
+		}
+
+		// categories that are no longer listed (became managed or unregistered) should not stay hidden
+		for (auto It = AppliedEngineCategories.CreateIterator(); It; ++It)
+		{
+			if (!Seen.Contains(It->Key))
+			{
+				if (!It->Value.bVisible)
+				{
+					PermListAccess->RemoveDenyListItem(OWNER_ID, It->Key);
+					bVisibilityChanged = true;
+				}
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	if (bVisibilityChanged)
+	{
+		PermListAccess->NotifyChanged();
+	}
+
+	if (bVisibilityChanged || bOrderChanged)
+	{
+		RequestToolbarRefresh();
+	}
+}
+
+void UEnhancedPaletteSubsystem::ApplyManagedCategorySettings()
+{
+	EPP_TRACE_SCOPE(EnhancedPalette_ApplyManagedCategorySettings);
 	FPaletteScopedTimeLogger ScopedLog(FPaletteScopedTimeLogger::END, TEXT("ApplyManagedCategorySettings"), ELogVerbosity::Verbose);
 
 	auto& Access = GetModuleRef();
+	bool bInfoChanged = false;
 	for (const TSharedPtr<FManagedCategory>& Ptr : ManagedCategories)
 	{
 		if (Ptr->bDirtyInfo)
 		{
 			Ptr->bDirtyInfo = false;
-			if (Ptr->UpdateRegistration(this, Access))
-			{
-				Access.NotifyCategoryRefreshed(Ptr->UniqueId);
-			}
+			// items are unaffected by info change, so no category refresh broadcast that rebuilds content
+			bInfoChanged |= Ptr->UpdateRegistration(this, Access);
 		}
 	}
+
+	if (bInfoChanged)
+	{
+		RequestToolbarRefresh();
+	}
 }
 
 void UEnhancedPaletteSubsystem::ApplyRecentListSettings()
 {
+	EPP_TRACE_SCOPE(EnhancedPalette_ApplyRecentListSettings);
 	FPaletteScopedTimeLogger ScopedLog(FPaletteScopedTimeLogger::END, TEXT("ApplyRecentListSettings"), ELogVerbosity::Verbose);
 	// set recent list w/notify
 	GetModuleRef().SetRecentList(GetDefault<UEnhancedPaletteSettings>()->RecentlyPlaced);
@@ -690,28 +1844,53 @@ void UEnhancedPaletteSubsystem::OnSettingsPanelSelected()
 {
 	UE_LOG(LogEnhancedPalette, Verbose, TEXT("OnSettingsPanelSelected"));
 
+	++Counters.SettingsImports;
+
 	auto& ModuleRef = GetModuleRef();
 	auto* Settings = GetMutableDefault<UEnhancedPaletteSettings>();
 
-	const TArray<FStandardPlacementCategoryInfo> LastCycleData = Settings->EngineCategories;
-	Settings->EngineCategories.Empty();
+	TArray<FStandardPlacementCategoryInfo> LastCycleData = MoveTemp(Settings->EngineCategories);
+	Settings->EngineCategories.Reset();
+
+	TMap<FName, int32> LastCycleIndex;
+	LastCycleIndex.Reserve(LastCycleData.Num());
+	for (int32 Index = 0; Index < LastCycleData.Num(); ++Index)
+	{
+		LastCycleIndex.Add(LastCycleData[Index].UniqueId, Index);
+	}
+
+	TSet<FName> ManagedIds;
+	ManagedIds.Reserve(ManagedCategories.Num());
+	for (const TSharedPtr<FManagedCategory>& Ptr : ManagedCategories)
+	{
+		ManagedIds.Add(Ptr->UniqueId);
+	}
+	for (const TPair<FName, TSharedPtr<FRestoredCategory>>& Pair : RestoredCategories)
+	{
+		ManagedIds.Add(Pair.Key);
+	}
+
+	TSet<FName> KnownCategories(Settings->CachedKnownCategories);
 
 	// import visibility and order switches
 	for (const FName& UniqueHandle : ModuleRef.GetRegisteredCategoryNames())
 	{
-		Settings->CachedKnownCategories.AddUnique(UniqueHandle);
-		// display only categories not managed by plugin (registered in engine)
-		const bool bIsManaged = FindManagedCategory(UniqueHandle) != nullptr;
+		bool bAlreadyKnown = false;
+		KnownCategories.Add(UniqueHandle, &bAlreadyKnown);
+		if (!bAlreadyKnown)
+		{
+			Settings->CachedKnownCategories.Add(UniqueHandle);
+		}
 
-		if (bIsManaged)
-		{ // either rename or something else
-			Settings->EngineCategories.RemoveAll([UniqueHandle](const FStandardPlacementCategoryInfo& Info) { return Info.UniqueId == UniqueHandle; });
+		// display only categories not managed by plugin (registered in engine)
+		if (ManagedIds.Contains(UniqueHandle))
+		{
 			continue;
 		}
 
-		if (const FStandardPlacementCategoryInfo* LastCycleInfo = LastCycleData.FindByKey(UniqueHandle))
+		if (const int32* LastCycleInfo = LastCycleIndex.Find(UniqueHandle))
 		{ // pick last cycle data
-			Settings->EngineCategories.Emplace(*LastCycleInfo);
+			Settings->EngineCategories.Emplace(MoveTemp(LastCycleData[*LastCycleInfo]));
 			continue;
 		}
 
@@ -732,21 +1911,66 @@ void UEnhancedPaletteSubsystem::OnSettingsPanelSelected()
 	});
 
 	// import recent list to settings panel
-	Settings->RecentlyPlaced.Empty();
-	for (const FActorPlacementInfo& Element : ModuleRef->GetRecentlyPlaced())
+	ImportRecentList();
+}
+
+void UEnhancedPaletteSubsystem::ImportRecentList()
+{
+	auto& ModuleRef = GetModuleRef();
+	auto* Settings = GetMutableDefault<UEnhancedPaletteSettings>();
+
+	const TArray<FActorPlacementInfo>& Recent = ModuleRef->GetRecentlyPlaced();
+
+	// most of the time list is identical to what was imported last time
+	if (Recent.Num() == Settings->RecentlyPlaced.Num())
 	{
+		bool bIdentical = true;
+		for (int32 Index = 0; Index < Recent.Num() && bIdentical; ++Index)
+		{
+			bIdentical = Recent[Index].Factory == Settings->RecentlyPlaced[Index].Factory
+				&& Recent[Index].ObjectPath == Settings->RecentlyPlaced[Index].ObjectPath;
+		}
+		if (bIdentical)
+		{
+			return;
+		}
+	}
+
+	// reuse already imported entries and their labels
+	TMap<uint32, int32> PreviousByHash;
+	PreviousByHash.Reserve(Settings->RecentlyPlaced.Num());
+	for (int32 Index = 0; Index < Settings->RecentlyPlaced.Num(); ++Index)
+	{
+		const FConfigActorPlacementInfo& Desc = Settings->RecentlyPlaced[Index];
+		PreviousByHash.Add(FPlacementModeModuleAccess::HashRecentEntry(Desc.Factory, Desc.ObjectPath), Index);
+	}
+
+	TArray<FConfigActorPlacementInfo> Previous = MoveTemp(Settings->RecentlyPlaced);
+	Settings->RecentlyPlaced.Reset(Recent.Num());
+
+	for (const FActorPlacementInfo& Element : Recent)
+	{
+		const int32* PreviousIndex = PreviousByHash.Find(FPlacementModeModuleAccess::HashRecentEntry(Element.Factory, Element.ObjectPath));
+		if (PreviousIndex
+			&& Previous[*PreviousIndex].Factory == Element.Factory
+			&& Previous[*PreviousIndex].ObjectPath == Element.ObjectPath)
+		{
+			Settings->RecentlyPlaced.Add(MoveTemp(Previous[*PreviousIndex]));
+			continue;
+		}
+
 		FConfigActorPlacementInfo Desc;
 		Desc.Factory = Element.Factory;
 		Desc.ObjectPath = Element.ObjectPath;
 
 		{
-			FStringBuilderBase SB;
+			TStringBuilder<256> SB;
 			if (!Desc.Factory.IsEmpty())
 			{
 				int32 IndexOfLastSlash = INDEX_NONE;
 				Desc.Factory.FindLastChar(TEXT('.'), IndexOfLastSlash);
 				SB.Append(TEXT("F="));
-				SB.Append(Desc.Factory.Mid(IndexOfLastSlash + 1));
+				SB.Append(FStringView(Desc.Factory).Mid(IndexOfLastSlash + 1));
 				SB.Append(TEXT(" "));
 			}
 			if (!Desc.ObjectPath.IsEmpty())
@@ -773,6 +1997,9 @@ void UEnhancedPaletteSubsystem::OnSettingsPanelModified(UObject* Obj, FPropertyC
 
 	UE_LOG(LogEnhancedPalette, Verbose, TEXT("OnSettingsChanged %s :: %s"), *MemberPropName.ToString(), *ChangedPropName.ToString());
 
+	// restart settle timer, interactive changes keep pipeline on hold while they keep coming
+	LastSettingsEditTime = FPlatformTime::Seconds();
+
 	auto IsMemberOf = [](const FProperty* InProperty, const UStruct* InStruct) -> bool
 	{
 		return InProperty && InProperty->GetOwnerStruct()->IsChildOf(InStruct);
@@ -799,18 +2026,49 @@ void UEnhancedPaletteSubsystem::OnSettingsPanelModified(UObject* Obj, FPropertyC
 		else if (MemberPropName == GET_MEMBER_NAME_CHECKED(UEnhancedPaletteSettings, StaticCategories))
 		{
 			RequestSettingsSave();
+
+			// categories added, removed or replaced as a whole
+			if (bSettingsChange)
+			{
+				RequestDiscover();
+			}
 		}
 	}
 
 	if (bCategoryChange || bItemChange)
 	{
 		RequestSettingsSave();
-		RequestDiscover();
-		// since it is difficult which category data was modified - mark all static categories as dirty
-		for (const FStaticPlacementCategoryInfo& Info : Settings->StaticCategories)
+
+		const int32 CategoryIndex = Evt.GetArrayIndex(GET_MEMBER_NAME_STRING_CHECKED(UEnhancedPaletteSettings, StaticCategories));
+		if (!Settings->StaticCategories.IsValidIndex(CategoryIndex))
+		{
+			// edit can not be resolved to a single category (multi-object edit or missing index data) - mark all static categories as dirty
+			RequestDiscover();
+			for (const FStaticPlacementCategoryInfo& Info : Settings->StaticCategories)
+			{
+				MarkCategoryDirty(Info.UniqueId, EManagedCategoryDirtyFlags::All);
+			}
+			return;
+		}
+
+		const FStaticPlacementCategoryInfo& Info = Settings->StaticCategories[CategoryIndex];
+
+		if (bCategoryChange && ChangedPropName == GET_MEMBER_NAME_CHECKED(FConfigPlacementCategoryInfo, UniqueId))
 		{
-			MarkCategoryDirty(Info.UniqueId, EManagedCategoryDirtyFlags::All);
+			// identity changed, discovery replaces the old category with a new one
+			RequestDiscover();
+			return;
 		}
+
+		const int32 ItemIndex = Evt.GetArrayIndex(GET_MEMBER_NAME_STRING_CHECKED(FStaticPlacementCategoryInfo, Items));
+		const bool bContentChange = bItemChange
+			|| ItemIndex != INDEX_NONE
+			|| ChangedPropName == GET_MEMBER_NAME_CHECKED(FStaticPlacementCategoryInfo, Items);
+
+		UE_LOG(LogEnhancedPalette, Verbose, TEXT("Static category %s changed: %s (item %d)"),
+			*Info.UniqueId.ToString(), bContentChange ? TEXT("Content") : TEXT("Info"), ItemIndex);
+
+		MarkCategoryDirty(Info.UniqueId, bContentChange ? EManagedCategoryDirtyFlags::Content : EManagedCategoryDirtyFlags::Info);
 	}
 }
 
@@ -841,12 +2099,27 @@ void UEnhancedPaletteSubsystem::OnSettingsPanelCommand(FName InCommand)
 	if (InCommand == SettingsCommand::ClearRecent)
 	{
 		GetModuleRef().SetRecentList({});
-		RequestToolbarContentRefresh();
+		RequestToolbarContentRefresh(FBuiltInPlacementCategories::RecentlyPlaced());
 	}
 }
 
+bool UEnhancedPaletteSubsystem::IsWidgetRefreshAllowed(double LastRefreshTime) const
+{
+	const float MaxRate = GetDefault<UEnhancedPaletteSettings>()->MaxWidgetRefreshRate;
+	return MaxRate <= 0.f || FPlatformTime::Seconds() - LastRefreshTime >= 1.0 / MaxRate;
+}
+
+bool UEnhancedPaletteSubsystem::AreSettingsEditsSettled() const
+{
+	// interactive edits are not waited for to finish, a cancelled drag never sends its final change
+	const double Delay = GetDefault<UEnhancedPaletteSettings>()->SettingsApplyDelay;
+	return FPlatformTime::Seconds() - LastSettingsEditTime >= Delay;
+}
+
 void UEnhancedPaletteSubsystem::TrySaveSettings()
 {
+	EPP_TRACE_SCOPE(EnhancedPalette_SaveSettings);
+
 	// BUG: force save settings section due to InstancedStructs save bug
 	if (auto Ptr = SettingsSectionPtr.Pin())
 	{
@@ -859,8 +2132,16 @@ void UEnhancedPaletteSubsystem::OnPlacementModeCategoryListChanged()
 	UE_LOG(LogEnhancedPalette, Verbose, TEXT("OnPlacementModeCategoryListChanged"));
 	if (bSubsystemReady)
 	{
+		if (SelfMutationDepth > 0)
+		{
+			// caused by plugin itself, import once mutation completes
+			bPendingCategoryListImport = true;
+			++Counters.SuppressedNotifications;
+			return;
+		}
+
 		// Try import data
-    	OnSettingsPanelSelected();
+		OnSettingsPanelSelected();
 	}
 }
 
@@ -902,6 +2183,8 @@ void UEnhancedPaletteSubsystem::OnCategoryBlueprintModified(class UBlueprint*, F
 	UE_LOG(LogEnhancedPalette, Verbose, TEXT("OnCategoryBlueprintModified %s "), *ID.ToString());
 	if (bSubsystemReady)
 	{
+		// content gathered by previous version of category is of no use
+		WorldCache->RemoveCategory(ID);
 		MarkCategoryDirty(ID, EManagedCategoryDirtyFlags::All);
 	}
 }
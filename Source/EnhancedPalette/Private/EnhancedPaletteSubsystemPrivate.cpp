@@ -9,6 +9,23 @@
 #include "EnhancedPaletteGlobals.h"
 #include "EnhancedPaletteCategory.h"
 #include "PlacementModeModuleAccess.h"
+#include "PaletteSearchIndex.h"
+#include "PaletteWorldIndex.h"
+#include "PaletteTagIndex.h"
+
+FCompiledBlueprintInfo::FCompiledBlueprintInfo(const UBlueprint* InBlueprint)
+{
+	PackageName = InBlueprint->GetPackage()->GetFName();
+	// generated class may be in flux during compilation, so hierarchy is recorded by paths
+	if (InBlueprint->GeneratedClass)
+	{
+		ClassHierarchy.Add(InBlueprint->GeneratedClass->GetClassPathName());
+	}
+	for (const UClass* Class = InBlueprint->ParentClass; Class; Class = Class->GetSuperClass())
+	{
+		ClassHierarchy.Add(Class->GetClassPathName());
+	}
+}
 
 FManagedCategory::FManagedCategory(FName InUniqueId, EManagedCategoryFlags InBase): UniqueId(InUniqueId), Flags(InBase)
 {
@@ -18,8 +35,32 @@ void FManagedCategory::AddReferencedObjects(FReferenceCollector& Collector, UObj
 {
 }
 
-void FManagedCategory::Tick(float DeltaTime)
+FManagedCategoryBudget FManagedCategory::GetBudget() const
+{
+	const UEnhancedPaletteSettings* Settings = GetDefault<UEnhancedPaletteSettings>();
+
+	FManagedCategoryBudget Budget;
+	Budget.GatherSeconds = Settings->GatherTimeBudgetMs / 1000.0;
+	Budget.TickSeconds = Settings->TickTimeBudgetMs / 1000.0;
+	Budget.MaxItems = Settings->ItemCountBudget;
+	return Budget;
+}
+
+void FManagedCategory::ForgetManagedItems(UEnhancedPaletteSubsystem* Owner)
+{
+	// removing category drops its items as well, only own bookkeeping needs to be updated
+	if (!IsEngineExitRequested())
+	{
+		Owner->GetSearchIndex().RemoveItems(ManagedIds);
+	}
+	ManagedIds.Empty();
+	ItemHashes.Empty();
+	bPopulated = false;
+}
+
+bool FManagedCategory::Tick(float DeltaTime)
 {
+	return false;
 }
 
 FConfigDrivenCategory::FConfigDrivenCategory(FName InUniqueId): FManagedCategory(InUniqueId, EManagedCategoryFlags::Type_Config)
@@ -61,7 +102,7 @@ void FConfigDrivenCategory::Register(UEnhancedPaletteSubsystem* Owner, FPlacemen
 			bool bWasRegistered = Access->RegisterPlacementCategory(Reg);
 			if (bWasRegistered)
 			{
-				// tbd
+				UpdateTraits(*CategoryInfo);
 				bRegistered = true;
 			}
 			else
@@ -88,6 +129,7 @@ bool FConfigDrivenCategory::UpdateRegistration(UEnhancedPaletteSubsystem* Owner,
 			Category->bSortable = CategoryInfo->bSortable;
 			Category->TagMetaData = CategoryInfo->TagMetaData;
 			Category->DisplayIcon = CategoryInfo->DisplayIcon.GetSlateIcon();
+			UpdateTraits(*CategoryInfo);
 			return true;
 		}
 	}
@@ -98,17 +140,26 @@ void FConfigDrivenCategory::Unregister(UEnhancedPaletteSubsystem* Owner, FPlacem
 {
 	if (bRegistered)
 	{
-		for (const FPlacementModeID& ManagedId : ManagedIds)
-		{
-			Access->UnregisterPlaceableItem(ManagedId);
-		}
+		ForgetManagedItems(Owner);
+
 		Access->UnregisterPlacementCategory(UniqueId);
 
-		ManagedIds.Empty();
 		bRegistered = false;
 	}
 }
 
+void FConfigDrivenCategory::UpdateTraits(const FStaticPlacementCategoryInfo& InCategory)
+{
+	if (InCategory.bKeepUpdatedWhileHidden)
+	{
+		SetFlag(EManagedCategoryFlags::Behavior_KeepUpdatedWhileHidden);
+	}
+	else
+	{
+		UnsetFlag(EManagedCategoryFlags::Behavior_KeepUpdatedWhileHidden);
+	}
+}
+
 void FConfigDrivenCategory::GatherPlaceableItems(UEnhancedPaletteSubsystem* Owner, TArray<TInstancedStruct<FConfigPlaceableItem>>& Out)
 {
 	if (const FStaticPlacementCategoryInfo* CategoryInfo = GetConfig())
@@ -148,7 +199,9 @@ void FAssetDrivenCategory::Register(UEnhancedPaletteSubsystem* Owner, FPlacement
 #if UE_VERSION_NEWER_THAN_OR_EQUAL(5, 5, 0)
 		Reg.ShortDisplayName = DefaultInstance->GetShortDisplayName();
 #endif
-		bool bWasRegistered = Access->RegisterPlacementCategory(Reg);
+		// category may be registered already from content snapshot, its registration and items are taken over
+		const bool bRestored = Owner->AdoptRestoredCategory(*this);
+		bool bWasRegistered = bRestored || Access->RegisterPlacementCategory(Reg);
 		if (bWasRegistered)
 		{
 			FString InstanceName = FString::Printf(TEXT("%s_%s"), *CategoryClass->GetName(), *UniqueId.ToString());
@@ -166,6 +219,12 @@ void FAssetDrivenCategory::Register(UEnhancedPaletteSubsystem* Owner, FPlacement
 			UpdateTraits(Owner, DefaultInstance);
 
 			bRegistered = true;
+
+			if (bRestored)
+			{
+				// snapshot info may be outdated
+				UpdateRegistration(Owner, Access);
+			}
 		}
 		else
 		{
@@ -194,12 +253,9 @@ void FAssetDrivenCategory::Unregister(UEnhancedPaletteSubsystem* Owner, FPlaceme
 
 		Instance = nullptr;
 		InstanceDefault = nullptr;
+		OriginalTickInterval = 0.f;
 
-		for (const FPlacementModeID& ManagedId : ManagedIds)
-		{
-			Access->UnregisterPlaceableItem(ManagedId);
-		}
-		ManagedIds.Empty();
+		ForgetManagedItems(Owner);
 
 		Access->UnregisterPlacementCategory(UniqueId);
 		bRegistered = false;
@@ -252,6 +308,33 @@ void FAssetDrivenCategory::UpdateTraits(UEnhancedPaletteSubsystem* Owner, const
 		UnsetFlag(EManagedCategoryFlags::DynamicTrait_Blueprint);
 	}
 
+	BlueprintBaseClasses.Reset(InCategory->BlueprintBaseClasses.Num());
+	for (const TSoftClassPtr<UObject>& BaseClass : InCategory->BlueprintBaseClasses)
+	{
+		if (!BaseClass.IsNull())
+		{
+			BlueprintBaseClasses.Add(BaseClass.ToSoftObjectPath().GetAssetPath());
+		}
+	}
+
+	BlueprintPaths.Reset(InCategory->BlueprintPaths.Num());
+	for (const FDirectoryPath& Path : InCategory->BlueprintPaths)
+	{
+		if (!Path.Path.IsEmpty())
+		{
+			FString PathString = Path.Path;
+			PathString.RemoveFromEnd(TEXT("/"));
+			BlueprintPaths.Add(PathString + TEXT("/"));
+		}
+	}
+
+	TArray<FName> IndexedTags;
+	InCategory->GetIndexedAssetTags(IndexedTags);
+	if (Owner && IndexedTags.Num())
+	{
+		Owner->GetTagIndex().AddTrackedTags(IndexedTags);
+	}
+
 	if (InCategory->bTrackingAssetChanges)
     {
 	    SetFlag(EManagedCategoryFlags::DynamicTrait_Asset);
@@ -269,6 +352,15 @@ void FAssetDrivenCategory::UpdateTraits(UEnhancedPaletteSubsystem* Owner, const
     {
 	    UnsetFlag(EManagedCategoryFlags::DynamicTrait_World);
     }
+
+	if (InCategory->bKeepUpdatedWhileHidden)
+	{
+		SetFlag(EManagedCategoryFlags::Behavior_KeepUpdatedWhileHidden);
+	}
+	else
+	{
+		UnsetFlag(EManagedCategoryFlags::Behavior_KeepUpdatedWhileHidden);
+	}
 }
 
 void FAssetDrivenCategory::GatherPlaceableItems(UEnhancedPaletteSubsystem* Owner, TArray<TInstancedStruct<FConfigPlaceableItem>>& Out)
@@ -276,16 +368,128 @@ void FAssetDrivenCategory::GatherPlaceableItems(UEnhancedPaletteSubsystem* Owner
 	if (bRegistered && ensure(IsValid(Instance)))
 	{
 		Out.Reserve(32);
-		Instance->GatherItems(Out);
+		Instance->GatherItems(Out, MakeGatherToken());
+	}
+}
+
+bool FAssetDrivenCategory::BeginSharedEnumeration(FARFilter& OutFilter)
+{
+	return bRegistered && IsValid(Instance) && Instance->NativeBeginSharedEnumeration(OutFilter);
+}
+
+void FAssetDrivenCategory::ReceiveSharedAsset(const FAssetData& InAsset)
+{
+	Instance->NativeReceiveSharedAsset(InAsset);
+}
+
+void FAssetDrivenCategory::EndSharedEnumeration()
+{
+	Instance->NativeEndSharedEnumeration();
+}
+
+void FAssetDrivenCategory::DiscardSharedEnumeration()
+{
+	if (IsValid(Instance))
+	{
+		Instance->NativeDiscardSharedEnumeration();
 	}
 }
 
-void FAssetDrivenCategory::Tick(float DeltaTime)
+bool FAssetDrivenCategory::IsInterestedInBlueprint(const FCompiledBlueprintInfo& Info) const
+{
+	if (BlueprintPaths.Num())
+	{
+		const FString PackageName = Info.PackageName.ToString();
+		const bool bInPaths = BlueprintPaths.ContainsByPredicate([&PackageName](const FString& Path)
+		{
+			return PackageName.StartsWith(Path);
+		});
+		if (!bInPaths)
+		{
+			return false;
+		}
+	}
+
+	if (BlueprintBaseClasses.Num())
+	{
+		const bool bDerived = BlueprintBaseClasses.ContainsByPredicate([&Info](const FTopLevelAssetPath& BaseClass)
+		{
+			return Info.ClassHierarchy.Contains(BaseClass);
+		});
+		if (!bDerived)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FAssetDrivenCategory::Tick(float DeltaTime)
 {
 	if (bRegistered && ensure(IsValid(Instance)))
 	{
-		Instance->Tick(DeltaTime);
+		return Instance->Tick(DeltaTime);
+	}
+	return false;
+}
+
+FManagedCategoryBudget FAssetDrivenCategory::GetBudget() const
+{
+	FManagedCategoryBudget Budget = FManagedCategory::GetBudget();
+	if (const UEnhancedPaletteCategory* Category = IsValid(Instance) ? Instance.Get() : InstanceDefault.Get())
+	{
+		if (Category->GatherTimeBudgetMs > 0)
+		{
+			Budget.GatherSeconds = Category->GatherTimeBudgetMs / 1000.0;
+		}
+		if (Category->TickTimeBudgetMs > 0)
+		{
+			Budget.TickSeconds = Category->TickTimeBudgetMs / 1000.0;
+		}
+		if (Category->ItemCountBudget > 0)
+		{
+			Budget.MaxItems = Category->ItemCountBudget;
+		}
+	}
+	return Budget;
+}
+
+bool FAssetDrivenCategory::RaiseTickInterval(float& OutNewInterval)
+{
+	if (!IsValid(Instance))
+	{
+		return false;
+	}
+
+	const float NewInterval = FMath::Clamp(Instance->TickInterval * 2.f, 1.f, 600.f);
+	if (NewInterval == Instance->TickInterval)
+	{
+		return false;
+	}
+
+	if (OriginalTickInterval <= 0.f)
+	{
+		OriginalTickInterval = Instance->TickInterval;
+	}
+	Instance->TickInterval = NewInterval;
+	OutNewInterval = NewInterval;
+	return true;
+}
+
+bool FAssetDrivenCategory::RestoreTickInterval()
+{
+	if (OriginalTickInterval <= 0.f)
+	{
+		return false;
+	}
+
+	if (IsValid(Instance))
+	{
+		Instance->TickInterval = OriginalTickInterval;
 	}
+	OriginalTickInterval = 0.f;
+	return true;
 }
 
 FExternalCategory::FExternalCategory(FName InUniqueId): FConfigDrivenCategory(InUniqueId, EManagedCategoryFlags::Type_External)
@@ -297,6 +501,58 @@ EManagedCategoryFlags FExternalCategory::GetCategoryTypeFlag() const
 	return EManagedCategoryFlags::Type_External;
 }
 
+void FExternalCategory::GatherPlaceableItems(UEnhancedPaletteSubsystem* Owner, TArray<TInstancedStruct<FConfigPlaceableItem>>& Out)
+{
+	GatheredHandles.Reset(ExternalItems.Num());
+	Out.Reserve(Out.Num() + ExternalItems.Num());
+	for (const TPair<FGuid, TInstancedStruct<FConfigPlaceableItem>>& Pair : ExternalItems)
+	{
+		GatheredHandles.Add(Pair.Key);
+		Out.Add(Pair.Value);
+	}
+}
+
+void FExternalCategory::OnItemsRegistered(TConstArrayView<int32> SourceIndices, TConstArrayView<FPlacementModeID> Ids)
+{
+	// full populate supersedes any pending delta
+	RegisteredHandles.Reset();
+	PendingAppend.Reset();
+	PendingRemove.Reset();
+
+	for (int32 Index = 0; Index < Ids.Num(); ++Index)
+	{
+		RegisteredHandles.Add(GatheredHandles[SourceIndices[Index]], Ids[Index]);
+	}
+	GatheredHandles.Empty();
+}
+
+FGuid FExternalCategory::AppendItem(TInstancedStruct<FConfigPlaceableItem> Item)
+{
+	const FGuid Handle = FGuid::NewGuid();
+	ExternalItems.Add(Handle, MoveTemp(Item));
+	PendingAppend.Add(Handle);
+	return Handle;
+}
+
+bool FExternalCategory::RemoveItem(const FGuid& Handle)
+{
+	if (!ExternalItems.Remove(Handle))
+	{
+		return false;
+	}
+
+	FPlacementModeID Id;
+	if (RegisteredHandles.RemoveAndCopyValue(Handle, Id))
+	{
+		PendingRemove.Add(Id);
+	}
+	else
+	{
+		PendingAppend.RemoveSingleSwap(Handle);
+	}
+	return true;
+}
+
 void FAssetDrivenCategory::AddReferencedObjects(FReferenceCollector& Collector, UObject* Owner)
 {
 	Collector.AddReferencedObject(Instance, Owner);
@@ -317,13 +573,22 @@ void FManagedCategoryChangeTracker::RegisterTrackers(UEnhancedPaletteSubsystem*
 {
 	// BLUEPRINT
 
-	GEditor->OnBlueprintCompiled().AddSPLambda(this, [Owner]()
+	// compile notification does not tell what was compiled, collect blueprints as they start compiling
+	GEditor->OnBlueprintPreCompile().AddSPLambda(this, [this](UBlueprint* Blueprint)
+	{
+		if (IsTrackingEnabled() && Blueprint)
+		{
+			PendingCompiledBlueprints.Emplace(Blueprint);
+		}
+	});
+	GEditor->OnBlueprintCompiled().AddSPLambda(this, [this, Owner]()
 	{
 		if (IsTrackingEnabled())
 		{
-			UE_LOG(LogEnhancedPalette, Verbose, TEXT("Tracking::OnBlueprintRecompiled"));
-			Owner->MarkCategoryDirty(EManagedCategoryFlags::DynamicTrait_Blueprint, EManagedCategoryDirtyFlags::Content);
+			UE_LOG(LogEnhancedPalette, Verbose, TEXT("Tracking::OnBlueprintRecompiled (%d blueprints)"), PendingCompiledBlueprints.Num());
+			Owner->MarkCategoryDirtyForBlueprints(PendingCompiledBlueprints);
 		}
+		PendingCompiledBlueprints.Reset();
 	});
 
 	// ASSET
@@ -364,36 +629,22 @@ void FManagedCategoryChangeTracker::RegisterTrackers(UEnhancedPaletteSubsystem*
 
 	// WORLD
 
-	FEditorDelegates::OnNewActorsDropped.AddSPLambda(this, [Owner](const TArray<UObject*>&, const TArray<AActor*>&)
-	{
-		if (IsTrackingEnabled())
-		{
-			UE_LOG(LogEnhancedPalette, Verbose, TEXT("Tracking::OnNewActorsDropped"));
-			Owner->MarkCategoryDirty(EManagedCategoryFlags::DynamicTrait_World, EManagedCategoryDirtyFlags::Content);
-		}
-	});
-	FEditorDelegates::OnNewActorsPlaced.AddSPLambda(this, [Owner](UObject*, const TArray<AActor*>&)
+	// world index reports placed, dropped, deleted and script spawned actors alike
+	Owner->GetWorldIndex().OnChanged().AddSPLambda(this, [Owner]()
 	{
 		if (IsTrackingEnabled())
 		{
-			UE_LOG(LogEnhancedPalette, Verbose, TEXT("Tracking::OnNewActorsPlaced"));
-			Owner->MarkCategoryDirty(EManagedCategoryFlags::DynamicTrait_World, EManagedCategoryDirtyFlags::Content);
-		}
-	});
-	FEditorDelegates::OnDeleteActorsEnd.AddSPLambda(this, [Owner]()
-	{
-		if (IsTrackingEnabled())
-		{
-			UE_LOG(LogEnhancedPalette, Verbose, TEXT("Tracking::OnDeleteActorsEnd"));
+			UE_LOG(LogEnhancedPalette, VeryVerbose, TEXT("Tracking::OnWorldActorsChanged"));
 			Owner->MarkCategoryDirty(EManagedCategoryFlags::DynamicTrait_World, EManagedCategoryDirtyFlags::Content);
 		}
 	});
+	// world categories are updated once new world is ready, previous one is only checked for cache validity
 	FEditorDelegates::OnMapOpened.AddSPLambda(this, [Owner](const FString& /* Filename */, bool /*bAsTemplate*/)
 	{
 		if (IsTrackingEnabled())
 		{
 			UE_LOG(LogEnhancedPalette, Verbose, TEXT("Tracking::OnMapOpened"));
-			Owner->MarkCategoryDirty(EManagedCategoryFlags::DynamicTrait_World, EManagedCategoryDirtyFlags::Content);
+			Owner->OnEditorMapOpened();
 		}
 	});
 	FEditorDelegates::OnMapLoad.AddSPLambda(this, [Owner](const FString& /* Filename */, FCanLoadMap& /*OutCanLoadMap*/)
@@ -401,7 +652,7 @@ void FManagedCategoryChangeTracker::RegisterTrackers(UEnhancedPaletteSubsystem*
 		if (IsTrackingEnabled())
 		{
 			UE_LOG(LogEnhancedPalette, Verbose, TEXT("Tracking::OnMapLoad"));
-			Owner->MarkCategoryDirty(EManagedCategoryFlags::DynamicTrait_World, EManagedCategoryDirtyFlags::Content);
+			Owner->OnEditorMapClosing();
 		}
 	});
 }
@@ -409,7 +660,12 @@ void FManagedCategoryChangeTracker::RegisterTrackers(UEnhancedPaletteSubsystem*
 void FManagedCategoryChangeTracker::UnregisterTrackers(UEnhancedPaletteSubsystem* Owner)
 {
 	// Trait Blueprint
-	GEditor->OnBlueprintReinstanced().RemoveAll(this);
+	if (GEditor)
+	{
+		GEditor->OnBlueprintPreCompile().RemoveAll(this);
+		GEditor->OnBlueprintCompiled().RemoveAll(this);
+	}
+	PendingCompiledBlueprints.Reset();
 
 	// Trait Asset
 	IAssetRegistry& Registry = IAssetRegistry::GetChecked();
@@ -419,9 +675,10 @@ void FManagedCategoryChangeTracker::UnregisterTrackers(UEnhancedPaletteSubsystem
 	FEditorDelegates::OnAssetsDeleted.RemoveAll(this);
 
 	// Trait World
-	FEditorDelegates::OnNewActorsDropped.RemoveAll(this);
-	FEditorDelegates::OnNewActorsPlaced.RemoveAll(this);
-	FEditorDelegates::OnDeleteActorsEnd.RemoveAll(this);
+	if (Owner)
+	{
+		Owner->GetWorldIndex().OnChanged().RemoveAll(this);
+	}
 	FEditorDelegates::OnMapLoad.RemoveAll(this);
 	FEditorDelegates::OnMapOpened.RemoveAll(this);
 }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "PlacementModeModuleAccess.h"
+#include "AssetRegistry/ARFilter.h"
 #include "EnhancedPaletteSettings.h"
 #include "EnhancedPaletteSubsystem.h"
 
@@ -11,6 +12,25 @@ enum class EManagedCategoryDirtyFlags;
 class UEnhancedPaletteSubsystem;
 struct FPlacementModeModuleAccess;
 
+// blueprint compiled since last compile notification
+struct FCompiledBlueprintInfo
+{
+	// package of blueprint asset
+	FName PackageName;
+	// generated class followed by all of its parent classes
+	TArray<FTopLevelAssetPath> ClassHierarchy;
+
+	explicit FCompiledBlueprintInfo(const class UBlueprint* InBlueprint);
+};
+
+// limits runs of category are measured against, 0 for no limit
+struct FManagedCategoryBudget
+{
+	double GatherSeconds = 0;
+	double TickSeconds = 0;
+	int32 MaxItems = 0;
+};
+
 /**
  *
  */
@@ -26,9 +46,29 @@ struct FManagedCategory
 	bool bDirtyContent = false;
 	// category info is dirty and needs to update info (usually due to blueprint changes)
 	bool bDirtyInfo = false;
+	// content was populated at least once, only later updates are deferred while palette is hidden
+	bool bPopulated = false;
+	// next populate takes content cached for current map instead of gathering
+	bool bRestoreFromWorldCache = false;
+	// assets of shared enumeration were delivered and await gather
+	bool bSharedEnumerationDone = false;
+	// content generation shared enumeration was done for, delivered assets are outdated once it changes
+	uint32 SharedEnumerationGeneration = 0;
+	// consecutive gathers discarded as superseded, capped so constantly changing content does not regather forever
+	int32 DiscardedGathers = 0;
+	// consecutive gathers and updates over budget
+	int32 GatherViolations = 0;
+	int32 TickViolations = 0;
+	// tracked changes do not dirty category after repeated slow gathers
+	bool bThrottled = false;
+
+	// incremented every time content is dirtied, gathers started for older generation are stale
+	FPaletteGatherToken::FCounter Generation = MakeShared<std::atomic<uint32>, ESPMode::ThreadSafe>(0);
 
 	// list of registered placement items
 	TArray<FPlacementModeID> ManagedIds;
+	// descriptor hashes of registered items, populate keeps registrations of unchanged descriptors
+	TMap<FGuid, uint64> ItemHashes;
 
 	explicit FManagedCategory(FName InUniqueId, EManagedCategoryFlags InBase);
 
@@ -38,8 +78,30 @@ struct FManagedCategory
 	virtual void Unregister(UEnhancedPaletteSubsystem* Owner, FPlacementModeModuleAccess&) = 0;
 	virtual bool UpdateRegistration(UEnhancedPaletteSubsystem* Owner, FPlacementModeModuleAccess&) = 0;
 	virtual void GatherPlaceableItems(UEnhancedPaletteSubsystem* Owner, TArray<TInstancedStruct<FConfigPlaceableItem>>&) = 0;
+	// called after populate registered gathered items, SourceIndices are positions within gathered list
+	virtual void OnItemsRegistered(TConstArrayView<int32> SourceIndices, TConstArrayView<FPlacementModeID> Ids) { }
+	// can compiled blueprint affect category content, checked for blueprint tracking categories
+	virtual bool IsInterestedInBlueprint(const FCompiledBlueprintInfo& Info) const { return true; }
+	// declare filter for shared asset enumeration done before gather, false to skip
+	virtual bool BeginSharedEnumeration(FARFilter& OutFilter) { return false; }
+	virtual void ReceiveSharedAsset(const FAssetData& InAsset) { }
+	virtual void EndSharedEnumeration() { }
+	virtual void DiscardSharedEnumeration() { }
+	virtual FManagedCategoryBudget GetBudget() const;
+	// double update interval of slow updating category, false if category can not be slowed down any further
+	virtual bool RaiseTickInterval(float& OutNewInterval) { return false; }
+	// undo raised update interval, true if interval was raised
+	virtual bool RestoreTickInterval() { return false; }
 	virtual void AddReferencedObjects(FReferenceCollector& Collector, UObject* Owner);
-	virtual void Tick(float DeltaTime);
+	// returns true if category was updated
+	virtual bool Tick(float DeltaTime);
+
+	uint32 GetGeneration() const { return Generation->load(); }
+	void BumpGeneration() { Generation->fetch_add(1); }
+	FPaletteGatherToken MakeGatherToken() const { return FPaletteGatherToken(Generation); }
+
+	// forget registered items before category itself is unregistered
+	void ForgetManagedItems(UEnhancedPaletteSubsystem* Owner);
 
 	bool HasFlag(EManagedCategoryFlags InFlag) const { return EnumHasAnyFlags(Flags, InFlag); }
 	void SetFlag(EManagedCategoryFlags InFlag) { EnumAddFlags(Flags, InFlag); }
@@ -60,6 +122,7 @@ struct FConfigDrivenCategory : FManagedCategory
 	virtual void Unregister(UEnhancedPaletteSubsystem* Owner, FPlacementModeModuleAccess&) override;
 	virtual bool UpdateRegistration(UEnhancedPaletteSubsystem* Owner, FPlacementModeModuleAccess&) override;
 	virtual void GatherPlaceableItems(UEnhancedPaletteSubsystem* Owner, TArray<TInstancedStruct<FConfigPlaceableItem>>&) override;
+	void UpdateTraits(const FStaticPlacementCategoryInfo& InCategory);
 };
 
 //  category configured via blueprint-collector
@@ -73,6 +136,13 @@ struct FAssetDrivenCategory : FManagedCategory
 	FDelegateHandle HandleOnCompiled;
 	FDelegateHandle HandleOnModified;
 
+	// declared blueprint tracking interest, empty lists match anything
+	TArray<FTopLevelAssetPath> BlueprintBaseClasses;
+	TArray<FString> BlueprintPaths;
+
+	// update interval of instance before it was first raised, zero while not raised
+	float OriginalTickInterval = 0.f;
+
 	explicit FAssetDrivenCategory(FName InUniqueId);
 
 	virtual EManagedCategoryFlags GetCategoryTypeFlag() const override;
@@ -81,20 +151,53 @@ struct FAssetDrivenCategory : FManagedCategory
 	virtual bool UpdateRegistration(UEnhancedPaletteSubsystem* Owner, FPlacementModeModuleAccess&) override;
 	void UpdateTraits(UEnhancedPaletteSubsystem* Owner, const UEnhancedPaletteCategory* InCategory);
 	virtual void GatherPlaceableItems(UEnhancedPaletteSubsystem* Owner, TArray<TInstancedStruct<FConfigPlaceableItem>>&) override;
+	virtual bool IsInterestedInBlueprint(const FCompiledBlueprintInfo& Info) const override;
+	virtual bool BeginSharedEnumeration(FARFilter& OutFilter) override;
+	virtual void ReceiveSharedAsset(const FAssetData& InAsset) override;
+	virtual void EndSharedEnumeration() override;
+	virtual void DiscardSharedEnumeration() override;
+	virtual FManagedCategoryBudget GetBudget() const override;
+	virtual bool RaiseTickInterval(float& OutNewInterval) override;
+	virtual bool RestoreTickInterval() override;
 	virtual void AddReferencedObjects(FReferenceCollector& Collector, UObject* Owner) override;
-	virtual void Tick(float DeltaTime) override;
+	virtual bool Tick(float DeltaTime) override;
 };
 
 // category created externally by interacting with subsystem API
 struct FExternalCategory : public FConfigDrivenCategory
 {
+	// category info, items are kept in ExternalItems
 	FStaticPlacementCategoryInfo Data;
 	bool bPendingKill = false;
 
+	// items by handle given out to API callers
+	TMap<FGuid, TInstancedStruct<FConfigPlaceableItem>> ExternalItems;
+	// handles of items currently registered in PM
+	TMap<FGuid, FPlacementModeID> RegisteredHandles;
+	// handles appended since last registration
+	TArray<FGuid> PendingAppend;
+	// registrations of items removed since last registration
+	TArray<FPlacementModeID> PendingRemove;
+	// handles in order of last gather
+	TArray<FGuid> GatheredHandles;
+
 	explicit FExternalCategory(FName InUniqueId);
 
 	virtual EManagedCategoryFlags GetCategoryTypeFlag() const override;
 	virtual const FStaticPlacementCategoryInfo* GetConfig() const { return &Data; }
+	virtual void GatherPlaceableItems(UEnhancedPaletteSubsystem* Owner, TArray<TInstancedStruct<FConfigPlaceableItem>>&) override;
+	virtual void OnItemsRegistered(TConstArrayView<int32> SourceIndices, TConstArrayView<FPlacementModeID> Ids) override;
+
+	FGuid AppendItem(TInstancedStruct<FConfigPlaceableItem> Item);
+	bool RemoveItem(const FGuid& Handle);
+	bool HasPendingDelta() const { return !PendingAppend.IsEmpty() || !PendingRemove.IsEmpty(); }
+};
+
+// category registered from content snapshot until its source category is discovered
+struct FRestoredCategory
+{
+	TArray<FPlacementModeID> ManagedIds;
+	TMap<FGuid, uint64> ItemHashes;
 };
 
 /**
@@ -109,4 +212,7 @@ struct FManagedCategoryChangeTracker : public TSharedFromThis<FManagedCategoryCh
 
 	void RegisterTrackers(UEnhancedPaletteSubsystem* Owner);
 	void UnregisterTrackers(UEnhancedPaletteSubsystem* Owner);
+
+	// blueprints that started compiling since last compile notification
+	TArray<FCompiledBlueprintInfo> PendingCompiledBlueprints;
 };
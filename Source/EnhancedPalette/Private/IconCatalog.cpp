@@ -0,0 +1,282 @@
+﻿// Copyright 2025, Aquanox.
+
+#include "IconCatalog.h"
+
+#include "EnhancedPaletteGlobals.h"
+#include "EnhancedPaletteModule.h"
+#include "Algo/Sort.h"
+#include "Algo/StableSort.h"
+#include "Containers/Ticker.h"
+#include "String/Find.h"
+#include "Styling/SlateStyle.h"
+#include "Styling/SlateStyleRegistry.h"
+
+static TSharedPtr<const FIconCatalog> GIconCatalog;
+static FTSTicker::FDelegateHandle GIconCatalogTicker;
+
+static bool IsValidBrush(const FName& InKey, const FSlateBrush* InBrush)
+{
+	const FVector2D Icon20x20(20, 20);
+
+	// TBD: hardcode size as any bigger image breaks ui in 5.5+
+	if (!InBrush || InBrush->GetImageSize() != Icon20x20 || InBrush->GetDrawType() != ESlateBrushDrawType::Image)
+		return false;
+
+	// name checks only for brushes that passed cheap checks
+	TStringBuilder<128> KeyString;
+	InKey.ToString(KeyString);
+	const FStringView KeyView = KeyString.ToView();
+	if (KeyView.EndsWith(TEXT(".Small"), ESearchCase::IgnoreCase)
+		|| UE::String::FindFirst(KeyView, TEXT("Overlay"), ESearchCase::IgnoreCase) != INDEX_NONE
+		|| UE::String::FindFirst(KeyView, TEXT("Status"), ESearchCase::IgnoreCase) != INDEX_NONE)
+		return false;
+
+	return true;
+}
+
+static bool CompareIconCodes(const FIconCatalogEntryPtr& Left, const FIconCatalogEntryPtr& Right)
+{
+	return Left->Icon.GetIconCode() < Right->Icon.GetIconCode();
+}
+
+TSharedRef<const FIconCatalog> FIconCatalog::Get()
+{
+	check(IsInGameThread());
+
+	if (BuildStep() && !GIconCatalogTicker.IsValid())
+	{
+		// remaining style sets are gathered on following frames
+		GIconCatalogTicker = FTSTicker::GetCoreTicker().AddTicker(TEXT("IconCatalog"), 0.f, [](float)
+		{
+			const bool bPending = BuildStep();
+			if (!bPending)
+			{
+				GIconCatalogTicker.Reset();
+			}
+			return bPending;
+		});
+	}
+	return GIconCatalog.ToSharedRef();
+}
+
+void FIconCatalog::Shutdown()
+{
+	if (GIconCatalogTicker.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(GIconCatalogTicker);
+		GIconCatalogTicker.Reset();
+	}
+	GIconCatalog.Reset();
+}
+
+bool FIconCatalog::BuildStep()
+{
+	const uint32 CurrentGeneration = FSimpleIconReference::GetStyleRegistryGeneration();
+	if (!GIconCatalog.IsValid() || GIconCatalog->Generation != CurrentGeneration)
+	{
+		TSharedRef<FIconCatalog> Catalog = MakeShareable(new FIconCatalog());
+		Catalog->Generation = CurrentGeneration;
+
+		TArray<FIconCatalogEntryPtr> Reused;
+		FSlateStyleRegistry::IterateAllStyles([&](const ISlateStyle& Style)
+		{
+			const FName StyleSetName = Style.GetStyleSetName();
+			// style sets that are still registered keep their section
+			const TSharedRef<const FStyleSection>* Existing = GIconCatalog.IsValid() ? GIconCatalog->Sections.Find(StyleSetName) : nullptr;
+			if (Existing && (*Existing)->Style == &Style)
+			{
+				Catalog->Sections.Add(StyleSetName, *Existing);
+				Reused.Append((*Existing)->Entries);
+			}
+			else
+			{
+				Catalog->PendingStyleSets.Add(StyleSetName);
+			}
+			return true;
+		});
+
+		Algo::Sort(Reused, &CompareIconCodes);
+		Catalog->MergeEntries(Reused);
+		GIconCatalog = Catalog;
+	}
+
+	if (GIconCatalog->IsComplete())
+	{
+		return false;
+	}
+
+	FPaletteScopedTimeLogger ScopedLog(FPaletteScopedTimeLogger::END, TEXT("FIconCatalog::BuildStep"), ELogVerbosity::Verbose);
+
+	// published instances are immutable, next one shares sections and entries with previous
+	TSharedRef<FIconCatalog> Catalog = MakeShareable(new FIconCatalog(*GIconCatalog));
+	const FName StyleSetName = Catalog->PendingStyleSets.Pop();
+	if (const ISlateStyle* Style = FSlateStyleRegistry::FindSlateStyle(StyleSetName))
+	{
+		TSharedRef<const FStyleSection> Section = BuildSection(*Style);
+		Catalog->Sections.Add(StyleSetName, Section);
+		Catalog->MergeEntries(Section->Entries);
+	}
+	GIconCatalog = Catalog;
+
+	return !Catalog->IsComplete();
+}
+
+void FIconCatalog::MergeEntries(TConstArrayView<FIconCatalogEntryPtr> InEntries)
+{
+	TArray<FIconCatalogEntryPtr> Merged;
+	Merged.Reserve(Entries.Num() + InEntries.Num());
+
+	int32 Left = 0;
+	int32 Right = 0;
+	while (Left < Entries.Num() && Right < InEntries.Num())
+	{
+		Merged.Add(CompareIconCodes(InEntries[Right], Entries[Left]) ? InEntries[Right++] : Entries[Left++]);
+	}
+	Merged.Append(Entries.GetData() + Left, Entries.Num() - Left);
+	Merged.Append(InEntries.GetData() + Right, InEntries.Num() - Right);
+	Entries = MoveTemp(Merged);
+
+	IconCodes.Reset(Entries.Num());
+	for (const FIconCatalogEntryPtr& Entry : Entries)
+	{
+		IconCodes.Add(Entry->Icon.GetIconCode());
+	}
+}
+
+uint64 FIconCatalog::ComputeCharMask(FStringView InStr)
+{
+	uint64 Mask = 0;
+	for (TCHAR Char : InStr)
+	{
+		if (Char >= TEXT('a') && Char <= TEXT('z'))
+			Mask |= 1ull << (Char - TEXT('a'));
+		else if (Char >= TEXT('0') && Char <= TEXT('9'))
+			Mask |= 1ull << (26 + Char - TEXT('0'));
+		else
+			Mask |= 1ull << 63;
+	}
+	return Mask;
+}
+
+TSharedRef<const FIconCatalog::FStyleSection> FIconCatalog::BuildSection(const ISlateStyle& Style)
+{
+	TSharedRef<FStyleSection> Section = MakeShared<FStyleSection>();
+	Section->StyleSetName = Style.GetStyleSetName();
+	Section->Style = &Style;
+
+	const FString LowerStyleSetName = Section->StyleSetName.ToString().ToLower();
+
+	for (const FName& Key : Style.GetStyleKeys())
+	{
+		const FSlateBrush* Brush = Style.GetOptionalBrush(Key, nullptr, nullptr);
+		if (!IsValidBrush(Key, Brush))
+			continue;
+
+		TSharedRef<FIconCatalogEntry> Entry = MakeShared<FIconCatalogEntry>();
+		Entry->Icon = FSimpleIconReference(Section->StyleSetName, Key);
+
+		Entry->SearchKey = Key.ToString().ToLower();
+		Entry->StyleNameLen = Entry->SearchKey.Len();
+		Entry->SearchKey.AppendChar(TEXT('\n'));
+		Entry->SearchKey.Append(LowerStyleSetName);
+		Entry->CharMask = ComputeCharMask(Entry->SearchKey);
+
+		Section->Entries.Add(MoveTemp(Entry));
+	}
+	Algo::Sort(Section->Entries, &CompareIconCodes);
+
+	UE_LOG(LogEnhancedPalette, Verbose, TEXT("Icon catalog: %d icons in %s"), Section->Entries.Num(), *Section->StyleSetName.ToString());
+	return Section;
+}
+
+int32 FIconCatalog::ScoreEntry(const FIconCatalogEntry& Entry, const FString& InQuery)
+{
+	const FString& Key = Entry.SearchKey;
+	const int32 KeyLen = Key.Len();
+	const int32 QueryLen = InQuery.Len();
+
+	// substring match, preferably at word start within style name
+	const int32 Found = Key.Find(InQuery, ESearchCase::CaseSensitive);
+	if (Found != INDEX_NONE)
+	{
+		int32 Score = 10000 - Found;
+		if (Found + QueryLen <= Entry.StyleNameLen)
+			Score += 2000;
+		if (Found == 0 || !FChar::IsAlnum(Key[Found - 1]))
+			Score += 1000;
+		return Score;
+	}
+
+	// subsequence match, rewarding consecutive characters and word starts and penalizing gaps
+	int32 Score = 0;
+	int32 KeyIndex = 0;
+	int32 LastMatch = INDEX_NONE;
+	for (int32 QueryIndex = 0; QueryIndex < QueryLen; ++QueryIndex)
+	{
+		const TCHAR Char = InQuery[QueryIndex];
+		while (KeyIndex < KeyLen && Key[KeyIndex] != Char)
+		{
+			++KeyIndex;
+		}
+		if (KeyIndex == KeyLen)
+		{
+			return INDEX_NONE;
+		}
+
+		if (LastMatch != INDEX_NONE && KeyIndex == LastMatch + 1)
+			Score += 15;
+		else if (LastMatch != INDEX_NONE)
+			Score -= FMath::Min(KeyIndex - LastMatch - 1, 10);
+
+		if (KeyIndex == 0 || !FChar::IsAlnum(Key[KeyIndex - 1]))
+			Score += 10;
+		if (KeyIndex < Entry.StyleNameLen)
+			Score += 5;
+
+		LastMatch = KeyIndex++;
+	}
+	return FMath::Max(Score, 0);
+}
+
+void FIconCatalog::Search(const FString& InQuery, TArray<FIconCatalogEntryPtr>& OutEntries) const
+{
+	OutEntries.Reset();
+
+	const FString Query = InQuery.TrimStartAndEnd().ToLower();
+	if (Query.IsEmpty())
+	{
+		OutEntries = Entries;
+		return;
+	}
+
+	const uint64 QueryMask = ComputeCharMask(Query);
+
+	struct FScored
+	{
+		int32 Index;
+		int32 Score;
+	};
+
+	TArray<FScored> Scored;
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		const FIconCatalogEntry& Entry = *Entries[Index];
+		if ((Entry.CharMask & QueryMask) != QueryMask)
+			continue;
+
+		const int32 Score = ScoreEntry(Entry, Query);
+		if (Score != INDEX_NONE)
+		{
+			Scored.Add({ Index, Score });
+		}
+	}
+
+	// stable to keep alphabetical order among equal scores
+	Algo::StableSort(Scored, [](const FScored& A, const FScored& B) { return A.Score > B.Score; });
+
+	OutEntries.Reserve(Scored.Num());
+	for (const FScored& Item : Scored)
+	{
+		OutEntries.Add(Entries[Item.Index]);
+	}
+}
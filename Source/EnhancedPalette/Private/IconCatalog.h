@@ -0,0 +1,89 @@
+﻿// Copyright 2025, Aquanox.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IconReference.h"
+
+class ISlateStyle;
+
+/**
+ * Icon entry within catalog with precomputed search data
+ */
+struct FIconCatalogEntry
+{
+	FSimpleIconReference Icon;
+	// lowercase style name followed by lowercase style set name
+	FString SearchKey;
+	// length of style name portion within search key
+	int32 StyleNameLen = 0;
+	// mask of characters present in search key, used for quick rejection
+	uint64 CharMask = 0;
+};
+
+using FIconCatalogEntryPtr = TSharedPtr<const FIconCatalogEntry>;
+
+/**
+ * Immutable list of icons available for selection across all registered slate style sets.
+ *
+ * Shared by all icon reference customizations and blueprint option helpers, built lazily on first use.
+ * Catalog is rebuilt only when slate style registry generation changes (style sets registered or unregistered),
+ * holders of previous instance keep using it until they ask again.
+ * Icons are gathered one style set per call or frame, so early instances may be incomplete (see IsComplete).
+ * Sections of style sets that are still registered are reused on rebuild.
+ */
+class FIconCatalog
+{
+public:
+	// Get current catalog, gathers next style set and continues on following frames until complete
+	static TSharedRef<const FIconCatalog> Get();
+	// Drop catalog and stop building it
+	static void Shutdown();
+
+	// Icons sorted by icon code
+	const TArray<FIconCatalogEntryPtr>& GetEntries() const { return Entries; }
+	// Icon codes sorted, matches GetEntries order
+	const TArray<FString>& GetIconCodes() const { return IconCodes; }
+
+	// Style registry generation catalog was built for
+	uint32 GetGeneration() const { return Generation; }
+	// All style sets of its generation are gathered
+	bool IsComplete() const { return PendingStyleSets.IsEmpty(); }
+
+	/**
+	 * Find icons matching query using fuzzy subsequence match.
+	 * Substring matches rank above scattered ones, matches within style name rank above style set matches.
+	 * @param InQuery search string, case-insensitive; empty query returns all icons
+	 * @param OutEntries matched icons ordered by relevance
+	 */
+	void Search(const FString& InQuery, TArray<FIconCatalogEntryPtr>& OutEntries) const;
+
+private:
+	// Icons gathered from single style set
+	struct FStyleSection
+	{
+		FName StyleSetName;
+		// style instance section was gathered from, only used for identity
+		const ISlateStyle* Style = nullptr;
+		TArray<FIconCatalogEntryPtr> Entries;
+	};
+
+	FIconCatalog() = default;
+	FIconCatalog(const FIconCatalog&) = default;
+
+	static uint64 ComputeCharMask(FStringView InStr);
+	static int32 ScoreEntry(const FIconCatalogEntry& Entry, const FString& InQuery);
+
+	static TSharedRef<const FStyleSection> BuildSection(const ISlateStyle& Style);
+	// start catalog for current registry generation or gather next style set, false once complete
+	static bool BuildStep();
+	// add sorted entries keeping entries and icon codes sorted
+	void MergeEntries(TConstArrayView<FIconCatalogEntryPtr> InEntries);
+
+	TMap<FName, TSharedRef<const FStyleSection>> Sections;
+	TArray<FIconCatalogEntryPtr> Entries;
+	TArray<FString> IconCodes;
+	// style sets of generation not gathered yet
+	TArray<FName> PendingStyleSets;
+	uint32 Generation = 0;
+};
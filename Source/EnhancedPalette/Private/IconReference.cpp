@@ -2,6 +2,8 @@
 
 #include "IconReference.h"
 
+#include "Styling/SlateStyleRegistry.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(IconReference)
 
 static FString MakeSlateIconCode(const FName& InStyleSet, const FName& InStyle)
@@ -48,7 +50,46 @@ FText FSimpleIconReference::GetDisplayText() const
 
 const FSlateBrush* FSimpleIconReference::GetBrush() const
 {
-	return GetSlateIcon().GetIcon();
+	check(IsInGameThread());
+
+	// brush memory is owned by style set, any registration change may have released it
+	const uint32 Generation = GetStyleRegistryGeneration();
+	if (CachedGeneration != Generation || CachedStyleSetName != StyleSetName || CachedStyleName != StyleName)
+	{
+		CachedBrush = GetSlateIcon().GetIcon();
+		CachedGeneration = Generation;
+		CachedStyleSetName = StyleSetName;
+		CachedStyleName = StyleName;
+	}
+	return CachedBrush;
+}
+
+uint32 FSimpleIconReference::GetStyleRegistryGeneration()
+{
+	static uint64 LastFrame = MAX_uint64;
+	static uint32 LastSignature = 0;
+	static uint32 Generation = 1;
+
+	if (LastFrame != GFrameCounter)
+	{
+		LastFrame = GFrameCounter;
+
+		// style set identity includes instance, so re-registering a set under same name is detected as well
+		uint32 Signature = 0;
+		FSlateStyleRegistry::IterateAllStyles([&Signature](const ISlateStyle& Style)
+		{
+			// order of registry is not stable, so combine order-independently
+			Signature ^= HashCombineFast(GetTypeHash(Style.GetStyleSetName()), PointerHash(&Style)) * 0x9E3779B1u;
+			return true;
+		});
+
+		if (Signature != LastSignature)
+		{
+			LastSignature = Signature;
+			Generation = Generation == MAX_uint32 ? 1 : Generation + 1;
+		}
+	}
+	return Generation;
 }
 
 const FString& FSimpleIconReference::GetIconCode() const
@@ -11,7 +11,7 @@ namespace EnhancedPaletteCustomizations
 	void Unregister();
 }
 
-class SSearchableComboBox;
+class SIconReferencePicker;
 class SWidget;
 
 // Customization for simple slate icon reference stub to make plugin self-contained
@@ -22,8 +22,6 @@ class FSimpleIconReferenceCustomization : public IPropertyTypeCustomization
 public:
 	static TSharedRef<IPropertyTypeCustomization> Make();
 
-	static void GatherIcons(TFunction<void(FName, FName)> Func);
-
 	virtual void CustomizeHeader(TSharedRef<IPropertyHandle> PropertyHandle, FDetailWidgetRow& HeaderRow, IPropertyTypeCustomizationUtils& CustomizationUtils) override;
 	virtual void CustomizeChildren(TSharedRef<IPropertyHandle> PropertyHandle, IDetailChildrenBuilder& ChildBuilder, IPropertyTypeCustomizationUtils& CustomizationUtils) override;
 
@@ -31,16 +29,11 @@ protected:
 	bool CanEdit() const;
 	const FSlateBrush* GetDisplayIcon() const;
 	FText GetDisplayText() const;
-	TSharedRef<SWidget> OnGenerateComboWidget(TSharedPtr<FString> InElement);
-	void OnSelectionChangedInternal(TSharedPtr<FString> Selected, ESelectInfo::Type);
-
-	void BuildComboItemList(TArray<TSharedPtr<FString>>& Output) const;
-	void ExtractIcon(const TSharedPtr<FString>& Element, FSimpleIconReference& Output) const;
+	void OnIconSelected(const FSimpleIconReference& Selected);
+	void OnResetToDefault();
 
 	TSharedPtr<IPropertyHandle> Handle;
-	TSharedPtr<SSearchableComboBox> Combobox;
-
-	TArray<TSharedPtr<FString>> ComboItemList;
+	TSharedPtr<SIconReferencePicker> Picker;
 
 	FSlateFontInfo Font;
 };
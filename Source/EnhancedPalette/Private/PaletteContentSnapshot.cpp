@@ -0,0 +1,309 @@
+﻿// Copyright 2025, Aquanox.
+
+#include "PaletteContentSnapshot.h"
+
+#include "EnhancedPaletteGlobals.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/Async.h"
+#include "Hash/CityHash.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+static constexpr uint32 SnapshotMagic = 0x45505053; // EPPS
+static constexpr int32 SnapshotVersion = 2;
+
+static bool CanPersistItem(const TInstancedStruct<FConfigPlaceableItem>& InItem)
+{
+	return InItem.IsValid() && !InItem.GetScriptStruct()->IsChildOf(FConfigPlaceableItem_Native::StaticStruct());
+}
+
+static bool SerializeItem(FArchive& Ar, TInstancedStruct<FConfigPlaceableItem>& InItem)
+{
+	// struct type and object references are written as paths, restore never loads referenced assets
+	FObjectAndNameAsStringProxyArchive Proxy(Ar, /*bInLoadIfFindFails*/ false);
+	InItem.Serialize(Proxy);
+	return !Proxy.IsError() && !Ar.IsError();
+}
+
+// object path of descriptors that resolve their asset through asset registry when making item
+static FSoftObjectPath GetRegistryDependentPath(const TInstancedStruct<FConfigPlaceableItem>& InItem)
+{
+	if (const FConfigPlaceableItem_AssetObject* AssetObject = InItem.GetPtr<FConfigPlaceableItem_AssetObject>())
+	{
+		return AssetObject->Object.ToSoftObjectPath();
+	}
+	if (const FConfigPlaceableItem_FactoryObject* FactoryObject = InItem.GetPtr<FConfigPlaceableItem_FactoryObject>())
+	{
+		return FactoryObject->Object.ToSoftObjectPath();
+	}
+	if (const FConfigPlaceableItem_ActorClass* ActorClass = InItem.GetPtr<FConfigPlaceableItem_ActorClass>())
+	{
+		return ActorClass->ActorClass.ToSoftObjectPath();
+	}
+	return FSoftObjectPath();
+}
+
+static FAssetData ResolveAssetData(const FSoftObjectPath& InPath)
+{
+	FAssetData Result;
+	if (UObject* Loaded = InPath.ResolveObject())
+	{
+		Result = FAssetData(Loaded);
+	}
+	else if (IAssetRegistry::GetChecked().TryGetAssetByObjectPath(InPath, Result) != UE::AssetRegistry::EExists::Exists)
+	{
+		Result = FAssetData();
+	}
+	return Result;
+}
+
+// asset data is stored explicitly, tags included, as property serialization of FAssetData drops them
+static void SerializeAssetData(FArchive& Ar, FAssetData& InOutAsset)
+{
+	bool bValid = InOutAsset.IsValid();
+	Ar << bValid;
+	if (!bValid)
+	{
+		return;
+	}
+
+	FName PackageName = InOutAsset.PackageName;
+	FName PackagePath = InOutAsset.PackagePath;
+	FName AssetName = InOutAsset.AssetName;
+	FString AssetClassPath = InOutAsset.AssetClassPath.ToString();
+	Ar << PackageName << PackagePath << AssetName << AssetClassPath;
+
+	FAssetDataTagMap Tags;
+	if (Ar.IsSaving())
+	{
+		Tags = InOutAsset.TagsAndValues.CopyMap();
+	}
+	int32 NumTags = Tags.Num();
+	Ar << NumTags;
+	if (Ar.IsLoading())
+	{
+		for (int32 Index = 0; Index < NumTags && !Ar.IsError(); ++Index)
+		{
+			FName Key;
+			FString Value;
+			Ar << Key << Value;
+			Tags.Add(Key, MoveTemp(Value));
+		}
+		FTopLevelAssetPath ClassPath;
+		ClassPath.TrySetPath(AssetClassPath);
+		InOutAsset = FAssetData(PackageName, PackagePath, AssetName, ClassPath, MoveTemp(Tags));
+	}
+	else
+	{
+		for (TPair<FName, FString>& Pair : Tags)
+		{
+			Ar << Pair.Key << Pair.Value;
+		}
+	}
+}
+
+bool FPaletteContentSnapshot::Save(TArray<uint8>& OutBytes) const
+{
+	OutBytes.Reset();
+
+	FMemoryWriter Writer(OutBytes, /*bIsPersistent*/ true);
+	FObjectAndNameAsStringProxyArchive Ar(Writer, false);
+
+	uint32 Magic = SnapshotMagic;
+	int32 Version = SnapshotVersion;
+	Ar << Magic;
+	Ar << Version;
+
+	FName Id = UniqueId;
+	FString Source = SourcePath;
+	FText Name = DisplayName;
+	FText ShortName = ShortDisplayName;
+	FString Icon = IconCode;
+	FString Tag = TagMetaData;
+	int32 Order = SortOrder;
+	bool bCanSort = bSortable;
+	Ar << Id << Source << Name << ShortName << Icon << Tag << Order << bCanSort;
+
+	int32 NumItems = Items.Num();
+	Ar << NumItems;
+	for (const TInstancedStruct<FConfigPlaceableItem>& Item : Items)
+	{
+		if (!CanPersistItem(Item) || !SerializeItem(Writer, const_cast<TInstancedStruct<FConfigPlaceableItem>&>(Item)))
+		{
+			OutBytes.Reset();
+			return false;
+		}
+
+		const FSoftObjectPath Path = GetRegistryDependentPath(Item);
+		FAssetData Resolved = Path.IsNull() ? FAssetData() : ResolveAssetData(Path);
+		SerializeAssetData(Ar, Resolved);
+	}
+	return !Ar.IsError();
+}
+
+bool FPaletteContentSnapshot::Load(const TArray<uint8>& InBytes)
+{
+	FMemoryReader Reader(InBytes, /*bIsPersistent*/ true);
+	FObjectAndNameAsStringProxyArchive Ar(Reader, false);
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Ar << Magic;
+	Ar << Version;
+	if (Magic != SnapshotMagic || Version != SnapshotVersion)
+	{
+		return false;
+	}
+
+	Ar << UniqueId << SourcePath << DisplayName << ShortDisplayName << IconCode << TagMetaData << SortOrder << bSortable;
+
+	int32 NumItems = 0;
+	Ar << NumItems;
+	if (Ar.IsError() || NumItems < 0 || NumItems > InBytes.Num())
+	{
+		return false;
+	}
+
+	Items.Reset(NumItems);
+	ResolvedAssets.Reset(NumItems);
+	for (int32 Index = 0; Index < NumItems; ++Index)
+	{
+		TInstancedStruct<FConfigPlaceableItem> Item;
+		FAssetData Resolved;
+		if (!SerializeItem(Reader, Item))
+		{
+			return false;
+		}
+		SerializeAssetData(Ar, Resolved);
+		if (Ar.IsError())
+		{
+			return false;
+		}
+		// item types removed since snapshot was taken are skipped
+		if (Item.IsValid())
+		{
+			Items.Add(MoveTemp(Item));
+			ResolvedAssets.Add(MoveTemp(Resolved));
+		}
+	}
+	return !UniqueId.IsNone();
+}
+
+TInstancedStruct<FConfigPlaceableItem> FPaletteContentSnapshot::MakeRestoreItem(int32 Index) const
+{
+	const TInstancedStruct<FConfigPlaceableItem>& Item = Items[Index];
+	const FAssetData& Resolved = ResolvedAssets[Index];
+	if (!Resolved.IsValid())
+	{
+		return Item;
+	}
+
+	TInstancedStruct<FConfigPlaceableItem> Result;
+	if (const FConfigPlaceableItem_FactoryObject* FactoryObject = Item.GetPtr<FConfigPlaceableItem_FactoryObject>())
+	{
+		Result.InitializeAs<FConfigPlaceableItem_FactoryAssetData>(FactoryObject->FactoryClass, Resolved);
+	}
+	else
+	{
+		Result.InitializeAs<FConfigPlaceableItem_AssetData>(Resolved);
+	}
+	// keep common overrides (names, sort order)
+	Result.GetMutable<FConfigPlaceableItem>() = Item.Get<FConfigPlaceableItem>();
+	return Result;
+}
+
+FString FPaletteContentSnapshot::GetSnapshotDir()
+{
+	return FPaths::ProjectSavedDir() / TEXT("EnhancedPalette");
+}
+
+FString FPaletteContentSnapshot::GetSnapshotPath(const FName& InUniqueId)
+{
+	return GetSnapshotDir() / FPaths::MakeValidFileName(InUniqueId.ToString()) + TEXT(".bin");
+}
+
+static FCriticalSection GSnapshotWriteLock;
+static TMap<FName, uint32> GSnapshotWriteSerials;
+
+void FPaletteContentSnapshot::WriteAsync(const FName& InUniqueId, TArray<uint8>&& InBytes)
+{
+	uint32 Serial;
+	{
+		FScopeLock Lock(&GSnapshotWriteLock);
+		Serial = ++GSnapshotWriteSerials.FindOrAdd(InUniqueId);
+	}
+
+	Async(EAsyncExecution::ThreadPool, [Id = InUniqueId, Path = GetSnapshotPath(InUniqueId), Bytes = MoveTemp(InBytes), Serial]()
+	{
+		// file is written outside of lock, only moving it into place is serialized with newer writes and deletes
+		const FString TempPath = FString::Printf(TEXT("%s.%u.tmp"), *Path, Serial);
+		if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath))
+		{
+			return;
+		}
+
+		FScopeLock Lock(&GSnapshotWriteLock);
+		// a newer write or delete superseded this one
+		if (GSnapshotWriteSerials.FindRef(Id) != Serial || !IFileManager::Get().Move(*Path, *TempPath, true, true))
+		{
+			IFileManager::Get().Delete(*TempPath, false, false, true);
+		}
+	});
+}
+
+void FPaletteContentSnapshot::ReadAll(TArray<FPaletteContentSnapshot>& OutSnapshots)
+{
+	const FString Dir = GetSnapshotDir();
+
+	TArray<FString> Files;
+	IFileManager::Get().FindFiles(Files, *(Dir / TEXT("*.bin")), true, false);
+
+	OutSnapshots.Reserve(OutSnapshots.Num() + Files.Num());
+	for (const FString& File : Files)
+	{
+		TArray<uint8> Bytes;
+		FPaletteContentSnapshot Snapshot;
+		if (FFileHelper::LoadFileToArray(Bytes, *(Dir / File)) && Snapshot.Load(Bytes))
+		{
+			OutSnapshots.Add(MoveTemp(Snapshot));
+		}
+		else
+		{
+			UE_LOG(LogEnhancedPalette, Log, TEXT("Content snapshot %s is outdated or corrupted, ignoring"), *File);
+		}
+	}
+}
+
+void FPaletteContentSnapshot::Delete(const FName& InUniqueId)
+{
+	const FString Path = GetSnapshotPath(InUniqueId);
+
+	FScopeLock Lock(&GSnapshotWriteLock);
+	// drop pending writes, ones already written are not moved into place after this
+	++GSnapshotWriteSerials.FindOrAdd(InUniqueId);
+	IFileManager::Get().Delete(*Path, false, false, true);
+}
+
+uint64 FPaletteContentSnapshot::HashItem(const TInstancedStruct<FConfigPlaceableItem>& InItem)
+{
+	if (!CanPersistItem(InItem))
+	{
+		return 0;
+	}
+
+	TArray<uint8> Bytes;
+	Bytes.Reserve(256);
+	FMemoryWriter Writer(Bytes, /*bIsPersistent*/ true);
+	if (!SerializeItem(Writer, const_cast<TInstancedStruct<FConfigPlaceableItem>&>(InItem)))
+	{
+		return 0;
+	}
+
+	const uint64 Hash = CityHash64(reinterpret_cast<const char*>(Bytes.GetData()), Bytes.Num());
+	return Hash != 0 ? Hash : 1;
+}
@@ -0,0 +1,60 @@
+﻿// Copyright 2025, Aquanox.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnhancedPaletteTypes.h"
+
+/**
+ * Gathered content of a managed category persisted between editor sessions.
+ *
+ * Stores category info and item descriptors, object references are stored as paths.
+ * Descriptors that look up asset registry when making items also store asset data resolved at save time,
+ * so they can be restored before initial asset scan completes.
+ * Native item descriptors can not be persisted, categories producing them are not stored.
+ */
+struct FPaletteContentSnapshot
+{
+	// category unique identifier
+	FName UniqueId;
+	// path of category class that produced the content
+	FString SourcePath;
+
+	FText DisplayName;
+	FText ShortDisplayName;
+	FString IconCode;
+	FString TagMetaData;
+	int32 SortOrder = 0;
+	bool bSortable = true;
+
+	// gathered item descriptors in gather order
+	TArray<TInstancedStruct<FConfigPlaceableItem>> Items;
+	// asset data of items resolved at save time, invalid for items that do not need asset registry
+	TArray<FAssetData> ResolvedAssets;
+
+	// serialize snapshot, fails if any of items can not be persisted
+	bool Save(TArray<uint8>& OutBytes) const;
+	// deserialize snapshot, fails on unknown or corrupted data
+	bool Load(const TArray<uint8>& InBytes);
+
+	static FString GetSnapshotDir();
+	static FString GetSnapshotPath(const FName& InUniqueId);
+
+	// write serialized snapshot on worker thread, only the latest write for category lands on disk
+	static void WriteAsync(const FName& InUniqueId, TArray<uint8>&& InBytes);
+	/**
+	 * Make descriptor to restore item from.
+	 * Registry dependent descriptors are replaced with equivalent ones carrying stored asset data.
+	 */
+	TInstancedStruct<FConfigPlaceableItem> MakeRestoreItem(int32 Index) const;
+
+	// read all stored snapshots
+	static void ReadAll(TArray<FPaletteContentSnapshot>& OutSnapshots);
+	static void Delete(const FName& InUniqueId);
+
+	/**
+	 * Compute hash of item descriptor content.
+	 * @return hash of serialized descriptor or 0 if descriptor can not be persisted
+	 */
+	static uint64 HashItem(const TInstancedStruct<FConfigPlaceableItem>& InItem);
+};
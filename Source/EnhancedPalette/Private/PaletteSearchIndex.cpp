@@ -0,0 +1,307 @@
+﻿// Copyright 2025, Aquanox.
+
+#include "PaletteSearchIndex.h"
+
+#include "EnhancedPaletteGlobals.h"
+#include "EnhancedPaletteTypes.h"
+#include "Algo/Sort.h"
+
+uint64 FPaletteSearchIndex::MakeTrigramKey(TCHAR A, TCHAR B, TCHAR C)
+{
+	return (static_cast<uint64>(A) << 42) | (static_cast<uint64>(B) << 21) | static_cast<uint64>(C);
+}
+
+uint64 FPaletteSearchIndex::MakePrefixKey(const TCHAR* InStr, int32 InLen)
+{
+	// prefixes live in a separate map, but keep top bit set to never collide with trigram keys if merged
+	return (1ull << 63) | (static_cast<uint64>(InStr[0]) << 21) | (InLen > 1 ? static_cast<uint64>(InStr[1]) : 0ull);
+}
+
+static bool IsWordStart(const FString& InStr, int32 Index)
+{
+	return Index == 0 || !FChar::IsAlnum(InStr[Index - 1]);
+}
+
+void FPaletteSearchIndex::AddItem(const FPlacementModeID& InId, const FPlaceableItem& InItem)
+{
+	if (IdToEntry.Contains(InId.UniqueId))
+	{
+		RemoveItem(InId);
+	}
+
+	const int32 EntryId = Entries.AddDefaulted();
+	FEntry& Entry = Entries[EntryId];
+	Entry.Id = InId;
+	Entry.DisplayName = InItem.DisplayName;
+	Entry.NativeName = InItem.NativeName;
+	Entry.ObjectPath = InItem.AssetData.IsValid() ? InItem.AssetData.GetObjectPathString() : FString();
+	Entry.bAlive = true;
+
+	const FString LowerDisplayName = Entry.DisplayName.ToString().ToLower();
+	Entry.DisplayNameLen = LowerDisplayName.Len();
+
+	Entry.SearchKey.Reserve(LowerDisplayName.Len() + Entry.NativeName.Len() + Entry.ObjectPath.Len() + 2);
+	Entry.SearchKey.Append(LowerDisplayName);
+	Entry.SearchKey.AppendChar(TEXT('\n'));
+	Entry.SearchKey.Append(Entry.NativeName.ToLower());
+	Entry.SearchKey.AppendChar(TEXT('\n'));
+	Entry.SearchKey.Append(Entry.ObjectPath.ToLower());
+
+	IdToEntry.Add(InId.UniqueId, EntryId);
+	IndexEntry(EntryId);
+}
+
+void FPaletteSearchIndex::IndexEntry(int32 EntryId)
+{
+	const FString& Key = Entries[EntryId].SearchKey;
+	const int32 KeyLen = Key.Len();
+
+	TSet<uint64, DefaultKeyFuncs<uint64>, TInlineSetAllocator<128>> Unique;
+	for (int32 Index = 0; Index + 2 < KeyLen; ++Index)
+	{
+		if (Key[Index] == TEXT('\n') || Key[Index + 1] == TEXT('\n') || Key[Index + 2] == TEXT('\n'))
+			continue;
+
+		const uint64 Trigram = MakeTrigramKey(Key[Index], Key[Index + 1], Key[Index + 2]);
+		bool bAlreadyInSet = false;
+		Unique.Add(Trigram, &bAlreadyInSet);
+		if (!bAlreadyInSet)
+		{
+			Trigrams.FindOrAdd(Trigram).Add(EntryId);
+		}
+	}
+
+	Unique.Reset();
+	for (int32 Index = 0; Index < KeyLen; ++Index)
+	{
+		if (Key[Index] == TEXT('\n') || !IsWordStart(Key, Index))
+			continue;
+
+		const bool bHasSecond = Index + 1 < KeyLen && Key[Index + 1] != TEXT('\n');
+		for (int32 PrefixLen = 1; PrefixLen <= (bHasSecond ? 2 : 1); ++PrefixLen)
+		{
+			const uint64 Prefix = MakePrefixKey(&Key[Index], PrefixLen);
+			bool bAlreadyInSet = false;
+			Unique.Add(Prefix, &bAlreadyInSet);
+			if (!bAlreadyInSet)
+			{
+				Prefixes.FindOrAdd(Prefix).Add(EntryId);
+			}
+		}
+	}
+}
+
+void FPaletteSearchIndex::RemoveItem(const FPlacementModeID& InId)
+{
+	RemoveItems(MakeArrayView(&InId, 1));
+}
+
+void FPaletteSearchIndex::RemoveItems(TConstArrayView<FPlacementModeID> InIds)
+{
+	for (const FPlacementModeID& Id : InIds)
+	{
+		int32 EntryId = INDEX_NONE;
+		if (IdToEntry.RemoveAndCopyValue(Id.UniqueId, EntryId))
+		{
+			// release string memory right away, posting lists are cleaned up on compaction
+			Entries[EntryId] = FEntry();
+			++NumDead;
+		}
+	}
+
+	CompactIfNeeded();
+}
+
+void FPaletteSearchIndex::Reset()
+{
+	Entries.Empty();
+	IdToEntry.Empty();
+	Trigrams.Empty();
+	Prefixes.Empty();
+	NumDead = 0;
+}
+
+void FPaletteSearchIndex::CompactIfNeeded()
+{
+	if (IdToEntry.Num() == 0)
+	{
+		Reset();
+		return;
+	}
+
+	// rebuild posting lists only when garbage dominates
+	if (NumDead < 1024 || NumDead < IdToEntry.Num())
+	{
+		return;
+	}
+
+	const int32 NumAlive = Entries.Num() - NumDead;
+	TArray<FEntry> OldEntries = MoveTemp(Entries);
+	Reset();
+
+	Entries.Reserve(NumAlive);
+	IdToEntry.Reserve(NumAlive);
+	for (FEntry& Entry : OldEntries)
+	{
+		if (Entry.bAlive)
+		{
+			const int32 EntryId = Entries.Add(MoveTemp(Entry));
+			IdToEntry.Add(Entries[EntryId].Id.UniqueId, EntryId);
+			IndexEntry(EntryId);
+		}
+	}
+}
+
+int32 FPaletteSearchIndex::ScoreEntry(const FEntry& Entry, const FString& InQuery) const
+{
+	const int32 Index = Entry.SearchKey.Find(InQuery, ESearchCase::CaseSensitive);
+	if (Index == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+	if (Index == 0)
+	{
+		// exact display name match goes first, then display name prefix
+		return InQuery.Len() == Entry.DisplayNameLen ? 0 : 1;
+	}
+	if (Entry.SearchKey[Index - 1] == TEXT('\n'))
+	{
+		// native name or object path prefix
+		return 2;
+	}
+	if (!FChar::IsAlnum(Entry.SearchKey[Index - 1]))
+	{
+		// word start
+		return 3;
+	}
+	return 4;
+}
+
+void FPaletteSearchIndex::Search(const FString& InQuery, int32 MaxResults, TArray<FPaletteSearchResult>& OutResults) const
+{
+	OutResults.Reset();
+
+	const FString Query = InQuery.TrimStartAndEnd().ToLower();
+	const int32 QueryLen = Query.Len();
+	if (QueryLen == 0 || IdToEntry.Num() == 0)
+	{
+		return;
+	}
+
+	// candidates view either a posting list directly or the intersection buffer
+	TConstArrayView<int32> Candidates;
+	TArray<int32> Intersection;
+
+	if (QueryLen >= 3)
+	{
+		TArray<const FPostingList*, TInlineAllocator<32>> Lists;
+		for (int32 Index = 0; Index + 2 < QueryLen; ++Index)
+		{
+			const FPostingList* List = Trigrams.Find(MakeTrigramKey(Query[Index], Query[Index + 1], Query[Index + 2]));
+			if (!List)
+			{
+				return;
+			}
+			Lists.AddUnique(List);
+		}
+
+		// start from the most selective list
+		Algo::Sort(Lists, [](const FPostingList* A, const FPostingList* B) { return A->Num() < B->Num(); });
+
+		Candidates = *Lists[0];
+		for (int32 ListIndex = 1; ListIndex < Lists.Num() && Candidates.Num(); ++ListIndex)
+		{
+			const FPostingList& Other = *Lists[ListIndex];
+			// first pass reads the posting list, later passes compact the buffer in place
+			if (ListIndex == 1)
+			{
+				Intersection.SetNumUninitialized(Candidates.Num(), EAllowShrinking::No);
+			}
+			int32 Write = 0;
+			int32 OtherIndex = 0;
+			for (int32 Read = 0; Read < Candidates.Num() && OtherIndex < Other.Num(); )
+			{
+				if (Candidates[Read] < Other[OtherIndex])
+				{
+					++Read;
+				}
+				else if (Other[OtherIndex] < Candidates[Read])
+				{
+					++OtherIndex;
+				}
+				else
+				{
+					Intersection[Write++] = Candidates[Read++];
+					++OtherIndex;
+				}
+			}
+			Intersection.SetNum(Write, EAllowShrinking::No);
+			Candidates = Intersection;
+		}
+	}
+	else if (const FPostingList* List = Prefixes.Find(MakePrefixKey(*Query, QueryLen)))
+	{
+		Candidates = *List;
+	}
+
+	struct FScored
+	{
+		int32 EntryId;
+		int32 Score;
+	};
+
+	auto IsBetter = [this](const FScored& A, const FScored& B)
+	{
+		if (A.Score != B.Score)
+		{
+			return A.Score < B.Score;
+		}
+		return Entries[A.EntryId].DisplayNameLen < Entries[B.EntryId].DisplayNameLen;
+	};
+	auto IsWorse = [&IsBetter](const FScored& A, const FScored& B) { return IsBetter(B, A); };
+
+	// with a result limit only best MaxResults are kept, heap top is the worst of them
+	const bool bBounded = MaxResults > 0 && MaxResults < Candidates.Num();
+
+	TArray<FScored> Scored;
+	Scored.Reserve(bBounded ? MaxResults : Candidates.Num());
+	for (int32 EntryId : Candidates)
+	{
+		const FEntry& Entry = Entries[EntryId];
+		if (!Entry.bAlive)
+			continue;
+
+		const int32 Score = ScoreEntry(Entry, Query);
+		if (Score == INDEX_NONE)
+			continue;
+
+		const FScored Item { EntryId, Score };
+		if (!bBounded)
+		{
+			Scored.Add(Item);
+		}
+		else if (Scored.Num() < MaxResults)
+		{
+			Scored.HeapPush(Item, IsWorse);
+		}
+		else if (IsBetter(Item, Scored.HeapTop()))
+		{
+			Scored.HeapPopDiscard(IsWorse, EAllowShrinking::No);
+			Scored.HeapPush(Item, IsWorse);
+		}
+	}
+
+	Algo::Sort(Scored, IsBetter);
+
+	OutResults.Reserve(Scored.Num());
+	for (const FScored& Item : Scored)
+	{
+		const FEntry& Entry = Entries[Item.EntryId];
+		FPaletteSearchResult& Result = OutResults.AddDefaulted_GetRef();
+		Result.CategoryId = Entry.Id.Category;
+		Result.NativeName = Entry.NativeName;
+		Result.DisplayName = Entry.DisplayName;
+		Result.ObjectPath = Entry.ObjectPath;
+		Result.Relevance = Item.Score;
+	}
+}
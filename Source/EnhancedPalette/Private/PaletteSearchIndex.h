@@ -0,0 +1,78 @@
+﻿// Copyright 2025, Aquanox.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IPlacementModeModule.h"
+
+struct FPaletteSearchResult;
+
+/**
+ * Search index over placeable items registered by managed categories.
+ *
+ * Each item is indexed by lowercase display name, native name and object path.
+ * Queries of 3+ characters intersect trigram posting lists and match any substring.
+ * Shorter queries use word prefix lists and only match at word starts, so "ch" finds "Chair" but not "Torch".
+ * Candidates are verified against the stored search key, so results are exact matches.
+ *
+ * Entry ids are never reused, so posting lists stay sorted by construction.
+ * Removal only tombstones an entry, posting lists are compacted once enough garbage accumulates.
+ */
+class FPaletteSearchIndex
+{
+public:
+	FPaletteSearchIndex() = default;
+
+	// Add registered item to index
+	void AddItem(const FPlacementModeID& InId, const FPlaceableItem& InItem);
+	// Remove registered item from index
+	void RemoveItem(const FPlacementModeID& InId);
+	// Remove multiple registered items from index
+	void RemoveItems(TConstArrayView<FPlacementModeID> InIds);
+	// Drop everything
+	void Reset();
+
+	int32 Num() const { return IdToEntry.Num(); }
+
+	/**
+	 * Find items matching query.
+	 * @param InQuery search string, case-insensitive
+	 * @param MaxResults maximum number of results to return, 0 for unlimited
+	 * @param OutResults results ordered by relevance
+	 */
+	void Search(const FString& InQuery, int32 MaxResults, TArray<FPaletteSearchResult>& OutResults) const;
+
+private:
+	struct FEntry
+	{
+		FPlacementModeID Id;
+		FText DisplayName;
+		FString NativeName;
+		FString ObjectPath;
+		// lowercase display name, native name and object path separated by newline
+		FString SearchKey;
+		// length of display name portion within search key
+		int32 DisplayNameLen = 0;
+		bool bAlive = false;
+	};
+
+	using FPostingList = TArray<int32>;
+
+	static uint64 MakeTrigramKey(TCHAR A, TCHAR B, TCHAR C);
+	static uint64 MakePrefixKey(const TCHAR* InStr, int32 InLen);
+
+	void IndexEntry(int32 EntryId);
+	int32 ScoreEntry(const FEntry& Entry, const FString& InQuery) const;
+	void CompactIfNeeded();
+
+	// entries, indexed by entry id
+	TArray<FEntry> Entries;
+	// placement id to entry id
+	TMap<FGuid, int32> IdToEntry;
+	// trigram to entry ids
+	TMap<uint64, FPostingList> Trigrams;
+	// 1 and 2 character word prefixes to entry ids
+	TMap<uint64, FPostingList> Prefixes;
+	// number of removed entries still referenced by posting lists
+	int32 NumDead = 0;
+};
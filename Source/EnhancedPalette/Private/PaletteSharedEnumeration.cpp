@@ -0,0 +1,144 @@
+﻿// Copyright 2025, Aquanox.
+
+#include "PaletteSharedEnumeration.h"
+
+#include "AssetRegistry/IAssetRegistry.h"
+
+int32 FPaletteSharedEnumeration::AddClient(const FARFilter& InFilter)
+{
+	FClient& Client = Clients.AddDefaulted_GetRef();
+	Client.Filter = InFilter;
+	IAssetRegistry::GetChecked().CompileFilter(InFilter, Client.Compiled);
+	return Clients.Num() - 1;
+}
+
+FPaletteSharedEnumeration::EGroupKey FPaletteSharedEnumeration::GetGroupKey(const FARCompiledFilter& InCompiled)
+{
+	if (InCompiled.ClassPaths.Num())
+		return EGroupKey::Class;
+	if (InCompiled.PackagePaths.Num())
+		return EGroupKey::PackagePath;
+	if (InCompiled.PackageNames.Num())
+		return EGroupKey::PackageName;
+	if (InCompiled.SoftObjectPaths.Num())
+		return EGroupKey::ObjectPath;
+	return EGroupKey::None;
+}
+
+template <typename T>
+static void MergeSet(TSet<T>& Merged, const TSet<T>& Other)
+{
+	// empty set does not restrict anything, so union with it is unrestricted too
+	if (Merged.Num() && Other.Num())
+	{
+		Merged.Append(Other);
+	}
+	else
+	{
+		Merged.Reset();
+	}
+}
+
+void FPaletteSharedEnumeration::MergeInto(FARCompiledFilter& Merged, const FARCompiledFilter& Other)
+{
+	MergeSet(Merged.PackageNames, Other.PackageNames);
+	MergeSet(Merged.PackagePaths, Other.PackagePaths);
+	MergeSet(Merged.SoftObjectPaths, Other.SoftObjectPaths);
+	MergeSet(Merged.ClassPaths, Other.ClassPaths);
+
+	if (Merged.TagsAndValues.Num() && Other.TagsAndValues.Num())
+	{
+		for (const auto& Pair : Other.TagsAndValues)
+		{
+			Merged.TagsAndValues.AddUnique(Pair.Key, Pair.Value);
+		}
+	}
+	else
+	{
+		Merged.TagsAndValues.Reset();
+	}
+
+	// only flags every client requires
+	Merged.WithoutPackageFlags &= Other.WithoutPackageFlags;
+	Merged.WithPackageFlags &= Other.WithPackageFlags;
+}
+
+FARFilter FPaletteSharedEnumeration::MakeFilter(const FARCompiledFilter& InCompiled)
+{
+	// compiled sets are already expanded, no recursion needed
+	FARFilter Filter;
+	Filter.PackageNames = InCompiled.PackageNames.Array();
+	Filter.PackagePaths = InCompiled.PackagePaths.Array();
+	Filter.SoftObjectPaths = InCompiled.SoftObjectPaths.Array();
+	Filter.ClassPaths = InCompiled.ClassPaths.Array();
+	Filter.TagsAndValues = InCompiled.TagsAndValues;
+	Filter.WithoutPackageFlags = InCompiled.WithoutPackageFlags;
+	Filter.WithPackageFlags = InCompiled.WithPackageFlags;
+	Filter.bIncludeOnlyOnDiskAssets = InCompiled.bIncludeOnlyOnDiskAssets;
+	return Filter;
+}
+
+int32 FPaletteSharedEnumeration::Run(TFunctionRef<void(int32, const FAssetData&)> InCallback) const
+{
+	IAssetRegistry& Registry = IAssetRegistry::GetChecked();
+
+	// clients sharing data source and restricting dimension, merging keeps that dimension restricted
+	TMap<TPair<bool, EGroupKey>, TArray<int32, TInlineAllocator<16>>> Groups;
+	for (int32 Index = 0; Index < Clients.Num(); ++Index)
+	{
+		Groups.FindOrAdd({ Clients[Index].Filter.bIncludeOnlyOnDiskAssets, GetGroupKey(Clients[Index].Compiled) }).Add(Index);
+	}
+
+	int32 NumEnumerations = 0;
+	for (const auto& GroupPair : Groups)
+	{
+		const auto& Group = GroupPair.Value;
+		if (GroupPair.Key.Value == EGroupKey::None)
+		{
+			// merging with unrestricted filter would turn shared pass into whole registry scan
+			for (const int32 ClientIndex : Group)
+			{
+				++NumEnumerations;
+				Registry.EnumerateAssets(Clients[ClientIndex].Filter, [&](const FAssetData& Asset)
+				{
+					InCallback(ClientIndex, Asset);
+					return true;
+				});
+			}
+			continue;
+		}
+
+		++NumEnumerations;
+
+		if (Group.Num() == 1)
+		{
+			// nothing to share, enumerate with exact filter
+			const int32 ClientIndex = Group[0];
+			Registry.EnumerateAssets(Clients[ClientIndex].Filter, [&](const FAssetData& Asset)
+			{
+				InCallback(ClientIndex, Asset);
+				return true;
+			});
+			continue;
+		}
+
+		FARCompiledFilter Merged = Clients[Group[0]].Compiled;
+		for (int32 GroupIndex = 1; GroupIndex < Group.Num(); ++GroupIndex)
+		{
+			MergeInto(Merged, Clients[Group[GroupIndex]].Compiled);
+		}
+
+		Registry.EnumerateAssets(MakeFilter(Merged), [&](const FAssetData& Asset)
+		{
+			for (const int32 ClientIndex : Group)
+			{
+				if (Registry.IsAssetIncludedByFilter(Asset, Clients[ClientIndex].Compiled))
+				{
+					InCallback(ClientIndex, Asset);
+				}
+			}
+			return true;
+		});
+	}
+	return NumEnumerations;
+}
@@ -0,0 +1,52 @@
+﻿// Copyright 2025, Aquanox.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/ARFilter.h"
+
+struct FAssetData;
+
+/**
+ * Single pass asset registry enumeration serving several filters.
+ *
+ * Filters of clients are compiled and merged into superset filters, registry is enumerated once per merged filter
+ * and each asset is dispatched to clients whose own filter includes it.
+ * Clients are grouped by bIncludeOnlyOnDiskAssets as on-disk and in-memory data can not be mixed,
+ * and by the dimension restricting their filter (class, package path, package name or object path),
+ * so merged filter stays answerable from registry indices instead of degrading into a full registry scan.
+ * Clients restricted by no such dimension are enumerated on their own.
+ */
+class FPaletteSharedEnumeration
+{
+public:
+	FPaletteSharedEnumeration() = default;
+
+	// Add client filter, returns client index
+	int32 AddClient(const FARFilter& InFilter);
+
+	int32 Num() const { return Clients.Num(); }
+
+	/**
+	 * Enumerate registry for all clients.
+	 * @param InCallback invoked with client index for each asset included by client filter
+	 * @return number of registry enumerations done
+	 */
+	int32 Run(TFunctionRef<void(int32, const FAssetData&)> InCallback) const;
+
+private:
+	struct FClient
+	{
+		FARFilter Filter;
+		FARCompiledFilter Compiled;
+	};
+
+	// dimension of compiled filter clients are grouped by
+	enum class EGroupKey : uint8 { None, Class, PackagePath, PackageName, ObjectPath };
+	static EGroupKey GetGroupKey(const FARCompiledFilter& InCompiled);
+
+	static void MergeInto(FARCompiledFilter& Merged, const FARCompiledFilter& Other);
+	static FARFilter MakeFilter(const FARCompiledFilter& InCompiled);
+
+	TArray<FClient> Clients;
+};
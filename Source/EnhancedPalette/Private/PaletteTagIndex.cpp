@@ -0,0 +1,234 @@
+﻿// Copyright 2025, Aquanox.
+
+#include "PaletteTagIndex.h"
+
+#include "AssetRegistry/IAssetRegistry.h"
+#include "AssetRegistry/ARFilter.h"
+#include "EnhancedPaletteGlobals.h"
+#include "EnhancedPaletteModule.h"
+
+FPaletteTagIndex::~FPaletteTagIndex()
+{
+	Shutdown();
+}
+
+void FPaletteTagIndex::Initialize()
+{
+	IAssetRegistry& Registry = IAssetRegistry::GetChecked();
+	Registry.OnAssetAdded().AddRaw(this, &FPaletteTagIndex::HandleAssetAdded);
+	Registry.OnAssetRemoved().AddRaw(this, &FPaletteTagIndex::HandleAssetRemoved);
+	Registry.OnAssetUpdated().AddRaw(this, &FPaletteTagIndex::HandleAssetUpdated);
+	Registry.OnAssetRenamed().AddRaw(this, &FPaletteTagIndex::HandleAssetRenamed);
+
+	if (Registry.IsLoadingAssets())
+	{
+		Registry.OnFilesLoaded().AddRaw(this, &FPaletteTagIndex::HandleFilesLoaded);
+	}
+	else
+	{
+		Build();
+	}
+}
+
+void FPaletteTagIndex::Shutdown()
+{
+	if (IAssetRegistry* Registry = IAssetRegistry::Get())
+	{
+		Registry->OnAssetAdded().RemoveAll(this);
+		Registry->OnAssetRemoved().RemoveAll(this);
+		Registry->OnAssetUpdated().RemoveAll(this);
+		Registry->OnAssetRenamed().RemoveAll(this);
+		Registry->OnFilesLoaded().RemoveAll(this);
+	}
+
+	bBuilt = false;
+	Values.Empty();
+	AssetValues.Empty();
+}
+
+void FPaletteTagIndex::AddTrackedTags(TConstArrayView<FName> InTags)
+{
+	TArray<FName> NewTags;
+	for (const FName Tag : InTags)
+	{
+		bool bAlreadyInSet = false;
+		TrackedTags.Add(Tag, &bAlreadyInSet);
+		if (!bAlreadyInSet && !Tag.IsNone())
+		{
+			TrackedTagList.Add(Tag);
+			NewTags.Add(Tag);
+		}
+	}
+
+	if (bBuilt && NewTags.Num())
+	{
+		IndexTags(NewTags);
+	}
+}
+
+void FPaletteTagIndex::HandleFilesLoaded()
+{
+	IAssetRegistry::GetChecked().OnFilesLoaded().RemoveAll(this);
+	Build();
+}
+
+void FPaletteTagIndex::Build()
+{
+	bBuilt = true;
+	Values.Reset();
+	AssetValues.Reset();
+
+	if (TrackedTagList.Num())
+	{
+		IndexTags(TrackedTagList);
+	}
+}
+
+void FPaletteTagIndex::IndexTags(TConstArrayView<FName> InTags)
+{
+	FPaletteScopedTimeLogger ScopedLog(FPaletteScopedTimeLogger::END, FString::Printf(TEXT("Indexing %d asset tags"), InTags.Num()), ELogVerbosity::Verbose);
+
+	// assets having any of the tags
+	FARFilter Filter;
+	for (const FName Tag : InTags)
+	{
+		Filter.TagsAndValues.Add(Tag);
+	}
+	Filter.bIncludeOnlyOnDiskAssets = true;
+
+	IAssetRegistry::GetChecked().EnumerateAssets(Filter, [this, InTags](const FAssetData& Asset)
+	{
+		AddAsset(Asset, InTags);
+		return true;
+	});
+}
+
+void FPaletteTagIndex::AddAsset(const FAssetData& InAsset, TConstArrayView<FName> InTags)
+{
+	FSoftObjectPath Path;
+	for (const FName Tag : InTags)
+	{
+		FString Value;
+		if (!InAsset.GetTagValue(Tag, Value))
+			continue;
+
+		if (Path.IsNull())
+		{
+			Path = InAsset.ToSoftObjectPath();
+		}
+
+		Values.FindOrAdd(Tag).FindOrAdd(Value).Add(Path);
+		AssetValues.FindOrAdd(Path).Emplace(Tag, MoveTemp(Value));
+	}
+}
+
+void FPaletteTagIndex::RemoveAsset(const FSoftObjectPath& InPath)
+{
+	TArray<FTagValue, TInlineAllocator<2>> Removed;
+	if (!AssetValues.RemoveAndCopyValue(InPath, Removed))
+		return;
+
+	for (const FTagValue& Pair : Removed)
+	{
+		TMap<FString, FAssetSet>* TagValues = Values.Find(Pair.Key);
+		if (!TagValues)
+			continue;
+
+		if (FAssetSet* Assets = TagValues->Find(Pair.Value))
+		{
+			Assets->Remove(InPath);
+			if (Assets->IsEmpty())
+			{
+				TagValues->Remove(Pair.Value);
+			}
+		}
+	}
+}
+
+void FPaletteTagIndex::HandleAssetAdded(const FAssetData& InAsset)
+{
+	// assets found by initial scan are indexed once it completes
+	if (bBuilt && TrackedTagList.Num())
+	{
+		AddAsset(InAsset, TrackedTagList);
+	}
+}
+
+void FPaletteTagIndex::HandleAssetRemoved(const FAssetData& InAsset)
+{
+	if (bBuilt)
+	{
+		RemoveAsset(InAsset.ToSoftObjectPath());
+	}
+}
+
+void FPaletteTagIndex::HandleAssetUpdated(const FAssetData& InAsset)
+{
+	if (bBuilt && TrackedTagList.Num())
+	{
+		RemoveAsset(InAsset.ToSoftObjectPath());
+		AddAsset(InAsset, TrackedTagList);
+	}
+}
+
+void FPaletteTagIndex::HandleAssetRenamed(const FAssetData& InAsset, const FString& InOldObjectPath)
+{
+	if (bBuilt && TrackedTagList.Num())
+	{
+		RemoveAsset(FSoftObjectPath(InOldObjectPath));
+		AddAsset(InAsset, TrackedTagList);
+	}
+}
+
+bool FPaletteTagIndex::FindAssets(FName InTag, const FString& InValue, TArray<FSoftObjectPath>& OutAssets) const
+{
+	if (!bBuilt || !TrackedTags.Contains(InTag))
+	{
+		return false;
+	}
+
+	const TMap<FString, FAssetSet>* TagValues = Values.Find(InTag);
+	if (const FAssetSet* Assets = TagValues ? TagValues->Find(InValue) : nullptr)
+	{
+		OutAssets.Reserve(OutAssets.Num() + Assets->Num());
+		for (const FSoftObjectPath& Path : *Assets)
+		{
+			OutAssets.Add(Path);
+		}
+	}
+	return true;
+}
+
+bool FPaletteTagIndex::FindAssetsWithTag(FName InTag, TArray<FSoftObjectPath>& OutAssets) const
+{
+	if (!bBuilt || !TrackedTags.Contains(InTag))
+	{
+		return false;
+	}
+
+	if (const TMap<FString, FAssetSet>* TagValues = Values.Find(InTag))
+	{
+		for (const TPair<FString, FAssetSet>& Pair : *TagValues)
+		{
+			for (const FSoftObjectPath& Path : Pair.Value)
+			{
+				OutAssets.Add(Path);
+			}
+		}
+	}
+	return true;
+}
+
+bool FPaletteTagIndex::GetValues(FName InTag, TArray<FString>& OutValues) const
+{
+	if (!bBuilt || !TrackedTags.Contains(InTag))
+	{
+		return false;
+	}
+
+	if (const TMap<FString, FAssetSet>* TagValues = Values.Find(InTag))
+	{
+		TagValues->GetKeys(OutValues);
+	}
+	return true;
+}
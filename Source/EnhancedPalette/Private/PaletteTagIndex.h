@@ -0,0 +1,64 @@
+﻿// Copyright 2025, Aquanox.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+struct FAssetData;
+
+/**
+ * Index of assets by asset registry tag value.
+ *
+ * Only tags categories declared interest in are indexed. Index is built once initial asset scan completes
+ * and kept up to date from asset registry events, tags declared later are added with one registry enumeration.
+ * Values are compared case-insensitively.
+ */
+class FPaletteTagIndex
+{
+public:
+	FPaletteTagIndex() = default;
+	~FPaletteTagIndex();
+
+	void Initialize();
+	void Shutdown();
+
+	// Start indexing tags
+	void AddTrackedTags(TConstArrayView<FName> InTags);
+	bool IsTracked(FName InTag) const { return TrackedTags.Contains(InTag); }
+	// Index is usable once initial asset scan completes
+	bool IsBuilt() const { return bBuilt; }
+	// Number of indexed assets
+	int32 Num() const { return AssetValues.Num(); }
+
+	// Find assets with tag value, returns false if tag can not be answered by index
+	bool FindAssets(FName InTag, const FString& InValue, TArray<FSoftObjectPath>& OutAssets) const;
+	// Find assets having tag with any value, returns false if tag can not be answered by index
+	bool FindAssetsWithTag(FName InTag, TArray<FSoftObjectPath>& OutAssets) const;
+	// Distinct values of tag, returns false if tag can not be answered by index
+	bool GetValues(FName InTag, TArray<FString>& OutValues) const;
+
+private:
+	using FAssetSet = TSet<FSoftObjectPath>;
+	using FTagValue = TPair<FName, FString>;
+
+	void Build();
+	void IndexTags(TConstArrayView<FName> InTags);
+	void AddAsset(const FAssetData& InAsset, TConstArrayView<FName> InTags);
+	void RemoveAsset(const FSoftObjectPath& InPath);
+
+	void HandleFilesLoaded();
+	void HandleAssetAdded(const FAssetData& InAsset);
+	void HandleAssetRemoved(const FAssetData& InAsset);
+	void HandleAssetUpdated(const FAssetData& InAsset);
+	void HandleAssetRenamed(const FAssetData& InAsset, const FString& InOldObjectPath);
+
+	TSet<FName> TrackedTags;
+	TArray<FName> TrackedTagList;
+	bool bBuilt = false;
+
+	// tag to value to assets
+	TMap<FName, TMap<FString, FAssetSet>> Values;
+	// indexed tag values of asset, used for removal
+	TMap<FSoftObjectPath, TArray<FTagValue, TInlineAllocator<2>>> AssetValues;
+};
@@ -0,0 +1,89 @@
+﻿// Copyright 2025, Aquanox.
+
+#include "PaletteWorldCache.h"
+
+void FPaletteWorldCache::SetCapacity(int32 InCapacity)
+{
+	Capacity = FMath::Max(0, InCapacity);
+	Trim();
+}
+
+FPaletteWorldCache::FMapEntry* FPaletteWorldCache::Touch(FName InMap)
+{
+	const int32 Index = Maps.IndexOfByPredicate([InMap](const FMapEntry& Entry) { return Entry.Map == InMap; });
+	if (Index == INDEX_NONE)
+	{
+		return nullptr;
+	}
+	if (Index != Maps.Num() - 1)
+	{
+		FMapEntry Entry = MoveTemp(Maps[Index]);
+		Maps.RemoveAt(Index);
+		Maps.Add(MoveTemp(Entry));
+	}
+	return &Maps.Last();
+}
+
+const FPaletteWorldCache::FItems* FPaletteWorldCache::Find(FName InMap, FName InCategory)
+{
+	FMapEntry* Entry = Touch(InMap);
+	return Entry ? Entry->Categories.Find(InCategory) : nullptr;
+}
+
+bool FPaletteWorldCache::Contains(FName InMap, FName InCategory) const
+{
+	const FMapEntry* Entry = Maps.FindByPredicate([InMap](const FMapEntry& Entry) { return Entry.Map == InMap; });
+	return Entry && Entry->Categories.Contains(InCategory);
+}
+
+void FPaletteWorldCache::Store(FName InMap, FName InCategory, const FItems& InItems)
+{
+	if (Capacity == 0 || InMap.IsNone())
+	{
+		return;
+	}
+
+	FMapEntry* Entry = Touch(InMap);
+	if (!Entry)
+	{
+		Entry = &Maps.AddDefaulted_GetRef();
+		Entry->Map = InMap;
+	}
+	Entry->Categories.Add(InCategory, InItems);
+
+	Trim();
+}
+
+void FPaletteWorldCache::Remove(FName InMap, FName InCategory)
+{
+	if (FMapEntry* Entry = Maps.FindByPredicate([InMap](const FMapEntry& Entry) { return Entry.Map == InMap; }))
+	{
+		Entry->Categories.Remove(InCategory);
+	}
+}
+
+void FPaletteWorldCache::RemoveMap(FName InMap)
+{
+	Maps.RemoveAll([InMap](const FMapEntry& Entry) { return Entry.Map == InMap; });
+}
+
+void FPaletteWorldCache::RemoveCategory(FName InCategory)
+{
+	for (FMapEntry& Entry : Maps)
+	{
+		Entry.Categories.Remove(InCategory);
+	}
+}
+
+void FPaletteWorldCache::Reset()
+{
+	Maps.Empty();
+}
+
+void FPaletteWorldCache::Trim()
+{
+	if (Maps.Num() > Capacity)
+	{
+		Maps.RemoveAt(0, Maps.Num() - Capacity);
+	}
+}
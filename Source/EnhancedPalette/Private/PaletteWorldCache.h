@@ -0,0 +1,54 @@
+﻿// Copyright 2025, Aquanox.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnhancedPaletteTypes.h"
+
+/**
+ * Gathered content of world tracking categories per map, bounded by number of maps.
+ *
+ * Lets the palette be restored right away when switching back to a recently edited map.
+ * Least recently used maps are evicted first.
+ */
+class FPaletteWorldCache
+{
+public:
+	using FItems = TArray<TInstancedStruct<FConfigPlaceableItem>>;
+
+	FPaletteWorldCache() = default;
+
+	// Maximum number of maps to keep, 0 disables cache
+	void SetCapacity(int32 InCapacity);
+	int32 GetCapacity() const { return Capacity; }
+
+	// Find content of category gathered for map, marks map as recently used
+	const FItems* Find(FName InMap, FName InCategory);
+	bool Contains(FName InMap, FName InCategory) const;
+	// Store content of category gathered for map
+	void Store(FName InMap, FName InCategory, const FItems& InItems);
+
+	// Drop content of category for map
+	void Remove(FName InMap, FName InCategory);
+	// Drop all content of map
+	void RemoveMap(FName InMap);
+	// Drop content of category for all maps
+	void RemoveCategory(FName InCategory);
+	void Reset();
+
+	int32 Num() const { return Maps.Num(); }
+
+private:
+	struct FMapEntry
+	{
+		FName Map;
+		TMap<FName, FItems> Categories;
+	};
+
+	FMapEntry* Touch(FName InMap);
+	void Trim();
+
+	// most recently used map goes last
+	TArray<FMapEntry> Maps;
+	int32 Capacity = 0;
+};
@@ -0,0 +1,354 @@
+﻿// Copyright 2025, Aquanox.
+
+#include "PaletteWorldIndex.h"
+
+#include "Editor.h"
+#include "EngineUtils.h"
+#include "EnhancedPaletteGlobals.h"
+#include "EnhancedPaletteModule.h"
+#include "Algo/Sort.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+FPaletteWorldIndex::~FPaletteWorldIndex()
+{
+	Shutdown();
+}
+
+void FPaletteWorldIndex::Initialize()
+{
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().AddRaw(this, &FPaletteWorldIndex::HandleActorAdded);
+		GEngine->OnLevelActorDeleted().AddRaw(this, &FPaletteWorldIndex::HandleActorDeleted);
+		GEngine->OnLevelActorFolderChanged().AddRaw(this, &FPaletteWorldIndex::HandleActorFolderChanged);
+		GEngine->OnLevelActorListChanged().AddRaw(this, &FPaletteWorldIndex::HandleInvalidatingChange);
+	}
+	FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FPaletteWorldIndex::HandleObjectPropertyChanged);
+	FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FPaletteWorldIndex::HandleLevelChanged);
+	FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FPaletteWorldIndex::HandleLevelChanged);
+	FEditorDelegates::MapChange.AddRaw(this, &FPaletteWorldIndex::HandleMapChange);
+}
+
+void FPaletteWorldIndex::Shutdown()
+{
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().RemoveAll(this);
+		GEngine->OnLevelActorDeleted().RemoveAll(this);
+		GEngine->OnLevelActorFolderChanged().RemoveAll(this);
+		GEngine->OnLevelActorListChanged().RemoveAll(this);
+	}
+	FCoreUObjectDelegates::OnObjectPropertyChanged.RemoveAll(this);
+	FWorldDelegates::LevelAddedToWorld.RemoveAll(this);
+	FWorldDelegates::LevelRemovedFromWorld.RemoveAll(this);
+	FEditorDelegates::MapChange.RemoveAll(this);
+
+	bBuilt = false;
+	IndexedWorld.Reset();
+	Actors.Empty();
+	ByClass.Empty();
+	ByTag.Empty();
+	ByFolder.Empty();
+}
+
+UWorld* FPaletteWorldIndex::GetEditorWorld()
+{
+	return GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+}
+
+bool FPaletteWorldIndex::ShouldIndex(const AActor* InActor) const
+{
+	// placement previews and other helper actors are transient
+	return IsValid(InActor)
+		&& !InActor->HasAnyFlags(RF_Transient | RF_ClassDefaultObject | RF_ArchetypeObject)
+		&& InActor->GetWorld() == IndexedWorld.Get();
+}
+
+void FPaletteWorldIndex::EnsureBuilt()
+{
+	UWorld* World = GetEditorWorld();
+	if (bBuilt && IndexedWorld.Get() == World)
+	{
+		return;
+	}
+
+	FPaletteScopedTimeLogger ScopedLog(FPaletteScopedTimeLogger::END, TEXT("Building world actor index"), ELogVerbosity::Verbose);
+
+	Actors.Reset();
+	ByClass.Reset();
+	ByTag.Reset();
+	ByFolder.Reset();
+
+	IndexedWorld = World;
+	bBuilt = World != nullptr;
+
+	if (World)
+	{
+		for (TActorIterator<AActor> It(World); It; ++It)
+		{
+			if (ShouldIndex(*It))
+			{
+				AddActor(*It);
+			}
+		}
+	}
+}
+
+void FPaletteWorldIndex::Invalidate()
+{
+	bBuilt = false;
+	Actors.Empty();
+	ByClass.Empty();
+	ByTag.Empty();
+	ByFolder.Empty();
+}
+
+void FPaletteWorldIndex::AddActor(AActor* InActor)
+{
+	const FObjectKey Key(InActor);
+	if (Actors.Contains(Key))
+	{
+		RemoveActor(Key);
+	}
+
+	FActorEntry& Entry = Actors.Add(Key);
+	Entry.Class = FObjectKey(InActor->GetClass());
+	Entry.Tags = InActor->Tags;
+	Entry.Folder = InActor->GetFolderPath();
+
+	ByClass.FindOrAdd(Entry.Class).Add(Key);
+	for (const FName& Tag : Entry.Tags)
+	{
+		ByTag.FindOrAdd(Tag).Add(Key);
+	}
+	if (!Entry.Folder.IsNone())
+	{
+		ByFolder.FindOrAdd(Entry.Folder).Add(Key);
+	}
+}
+
+void FPaletteWorldIndex::RemoveActor(FObjectKey InActor)
+{
+	FActorEntry Entry;
+	if (!Actors.RemoveAndCopyValue(InActor, Entry))
+	{
+		return;
+	}
+
+	auto RemoveFrom = [&InActor](auto& Map, const auto& MapKey)
+	{
+		if (FActorSet* Set = Map.Find(MapKey))
+		{
+			Set->Remove(InActor);
+			if (Set->IsEmpty())
+			{
+				Map.Remove(MapKey);
+			}
+		}
+	};
+
+	RemoveFrom(ByClass, Entry.Class);
+	for (const FName& Tag : Entry.Tags)
+	{
+		RemoveFrom(ByTag, Tag);
+	}
+	if (!Entry.Folder.IsNone())
+	{
+		RemoveFrom(ByFolder, Entry.Folder);
+	}
+}
+
+void FPaletteWorldIndex::ResolveActors(const FActorSet& InSet, TArray<AActor*>& OutActors) const
+{
+	OutActors.Reserve(OutActors.Num() + InSet.Num());
+	for (const FObjectKey& Key : InSet)
+	{
+		AActor* Actor = Cast<AActor>(Key.ResolveObjectPtr());
+		if (IsValid(Actor))
+		{
+			OutActors.Add(Actor);
+		}
+	}
+}
+
+void FPaletteWorldIndex::NotifyChanged()
+{
+	++Revision;
+	OnChangedPrivate.Broadcast();
+}
+
+int32 FPaletteWorldIndex::Num()
+{
+	EnsureBuilt();
+	return Actors.Num();
+}
+
+void FPaletteWorldIndex::FindActorsOfClass(const UClass* InClass, bool bIncludeSubclasses, TArray<AActor*>& OutActors)
+{
+	EnsureBuilt();
+
+	if (!bIncludeSubclasses)
+	{
+		if (const FActorSet* Set = ByClass.Find(FObjectKey(InClass)))
+		{
+			ResolveActors(*Set, OutActors);
+		}
+		return;
+	}
+
+	// number of distinct classes is small compared to number of actors
+	for (const TPair<FObjectKey, FActorSet>& Pair : ByClass)
+	{
+		const UClass* Class = Cast<UClass>(Pair.Key.ResolveObjectPtr());
+		if (Class && (!InClass || Class->IsChildOf(InClass)))
+		{
+			ResolveActors(Pair.Value, OutActors);
+		}
+	}
+}
+
+void FPaletteWorldIndex::FindActorsWithTag(FName InTag, TArray<AActor*>& OutActors)
+{
+	EnsureBuilt();
+
+	if (const FActorSet* Set = ByTag.Find(InTag))
+	{
+		ResolveActors(*Set, OutActors);
+	}
+}
+
+void FPaletteWorldIndex::FindActorsInFolder(FName InFolder, bool bIncludeSubfolders, TArray<AActor*>& OutActors)
+{
+	EnsureBuilt();
+
+	if (const FActorSet* Set = ByFolder.Find(InFolder))
+	{
+		ResolveActors(*Set, OutActors);
+	}
+
+	if (bIncludeSubfolders)
+	{
+		const FString Prefix = InFolder.ToString() + TEXT("/");
+		for (const TPair<FName, FActorSet>& Pair : ByFolder)
+		{
+			if (Pair.Key.ToString().StartsWith(Prefix))
+			{
+				ResolveActors(Pair.Value, OutActors);
+			}
+		}
+	}
+}
+
+int32 FPaletteWorldIndex::GetClassUsageCount(const UClass* InClass, bool bIncludeSubclasses)
+{
+	EnsureBuilt();
+
+	if (!bIncludeSubclasses)
+	{
+		const FActorSet* Set = ByClass.Find(FObjectKey(InClass));
+		return Set ? Set->Num() : 0;
+	}
+
+	int32 Count = 0;
+	for (const TPair<FObjectKey, FActorSet>& Pair : ByClass)
+	{
+		const UClass* Class = Cast<UClass>(Pair.Key.ResolveObjectPtr());
+		if (Class && (!InClass || Class->IsChildOf(InClass)))
+		{
+			Count += Pair.Value.Num();
+		}
+	}
+	return Count;
+}
+
+void FPaletteWorldIndex::GetMostUsedClasses(int32 MaxResults, TArray<TPair<UClass*, int32>>& OutClasses)
+{
+	EnsureBuilt();
+
+	OutClasses.Reset(ByClass.Num());
+	for (const TPair<FObjectKey, FActorSet>& Pair : ByClass)
+	{
+		if (UClass* Class = Cast<UClass>(Pair.Key.ResolveObjectPtr()))
+		{
+			OutClasses.Emplace(Class, Pair.Value.Num());
+		}
+	}
+
+	Algo::Sort(OutClasses, [](const TPair<UClass*, int32>& A, const TPair<UClass*, int32>& B)
+	{
+		return A.Value > B.Value;
+	});
+
+	if (MaxResults > 0 && OutClasses.Num() > MaxResults)
+	{
+		OutClasses.SetNum(MaxResults, EAllowShrinking::No);
+	}
+}
+
+void FPaletteWorldIndex::HandleActorAdded(AActor* InActor)
+{
+	if (!IsValid(InActor) || InActor->GetWorld() != GetEditorWorld())
+		return;
+
+	if (bBuilt && ShouldIndex(InActor))
+	{
+		AddActor(InActor);
+	}
+	NotifyChanged();
+}
+
+void FPaletteWorldIndex::HandleActorDeleted(AActor* InActor)
+{
+	if (!InActor || InActor->GetWorld() != GetEditorWorld())
+		return;
+
+	if (bBuilt)
+	{
+		RemoveActor(FObjectKey(InActor));
+	}
+	NotifyChanged();
+}
+
+void FPaletteWorldIndex::HandleActorFolderChanged(const AActor* InActor, FName OldPath)
+{
+	if (bBuilt && Actors.Contains(FObjectKey(InActor)))
+	{
+		AddActor(const_cast<AActor*>(InActor));
+		NotifyChanged();
+	}
+}
+
+void FPaletteWorldIndex::HandleObjectPropertyChanged(UObject* InObject, FPropertyChangedEvent& InEvent)
+{
+	if (InEvent.GetMemberPropertyName() != GET_MEMBER_NAME_CHECKED(AActor, Tags))
+		return;
+
+	AActor* Actor = Cast<AActor>(InObject);
+	if (bBuilt && Actor && Actors.Contains(FObjectKey(Actor)))
+	{
+		AddActor(Actor);
+		NotifyChanged();
+	}
+}
+
+void FPaletteWorldIndex::HandleLevelChanged(ULevel* InLevel, UWorld* InWorld)
+{
+	if (InWorld && InWorld == GetEditorWorld())
+	{
+		HandleInvalidatingChange();
+	}
+}
+
+void FPaletteWorldIndex::HandleMapChange(uint32 MapChangeFlags)
+{
+	// map switch is reported by subsystem once new world is ready, only drop stale data here
+	Invalidate();
+}
+
+void FPaletteWorldIndex::HandleInvalidatingChange()
+{
+	// changes without actor details (undo, paste, grouping) are rare enough to rebuild on next query
+	Invalidate();
+	NotifyChanged();
+}
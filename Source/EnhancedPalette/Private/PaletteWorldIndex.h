@@ -0,0 +1,84 @@
+﻿// Copyright 2025, Aquanox.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class AActor;
+class ULevel;
+class UWorld;
+
+/**
+ * Index of actors within editor world by class, tag and outliner folder.
+ *
+ * Built lazily on first query for current editor world and kept up to date from level actor events.
+ * Bulk changes that do not report individual actors (level streaming, undo, map change) invalidate the index,
+ * it is rebuilt on next query.
+ */
+class FPaletteWorldIndex
+{
+public:
+	FPaletteWorldIndex() = default;
+	~FPaletteWorldIndex();
+
+	void Initialize();
+	void Shutdown();
+
+	// Number of indexed actors
+	int32 Num();
+	// Incremented on every change of actors within editor world
+	uint32 GetRevision() const { return Revision; }
+
+	void FindActorsOfClass(const UClass* InClass, bool bIncludeSubclasses, TArray<AActor*>& OutActors);
+	void FindActorsWithTag(FName InTag, TArray<AActor*>& OutActors);
+	void FindActorsInFolder(FName InFolder, bool bIncludeSubfolders, TArray<AActor*>& OutActors);
+	// Number of actors of class within editor world
+	int32 GetClassUsageCount(const UClass* InClass, bool bIncludeSubclasses);
+	// Actor classes ordered by number of instances within editor world
+	void GetMostUsedClasses(int32 MaxResults, TArray<TPair<UClass*, int32>>& OutClasses);
+
+	// Called when actors within editor world changed
+	using FOnChanged = TMulticastDelegate<void()>;
+	FOnChanged& OnChanged() { return OnChangedPrivate; }
+
+private:
+	using FActorSet = TSet<FObjectKey>;
+
+	struct FActorEntry
+	{
+		FObjectKey Class;
+		TArray<FName> Tags;
+		FName Folder;
+	};
+
+	static UWorld* GetEditorWorld();
+	bool ShouldIndex(const AActor* InActor) const;
+
+	void EnsureBuilt();
+	void Invalidate();
+	void AddActor(AActor* InActor);
+	void RemoveActor(FObjectKey InActor);
+	void ResolveActors(const FActorSet& InSet, TArray<AActor*>& OutActors) const;
+	void NotifyChanged();
+
+	void HandleActorAdded(AActor* InActor);
+	void HandleActorDeleted(AActor* InActor);
+	void HandleActorFolderChanged(const AActor* InActor, FName OldPath);
+	void HandleObjectPropertyChanged(UObject* InObject, struct FPropertyChangedEvent& InEvent);
+	void HandleLevelChanged(ULevel* InLevel, UWorld* InWorld);
+	void HandleMapChange(uint32 MapChangeFlags);
+	void HandleInvalidatingChange();
+
+	// world index was built for, index is empty if world changed
+	TWeakObjectPtr<UWorld> IndexedWorld;
+	bool bBuilt = false;
+
+	TMap<FObjectKey, FActorEntry> Actors;
+	TMap<FObjectKey, FActorSet> ByClass;
+	TMap<FName, FActorSet> ByTag;
+	TMap<FName, FActorSet> ByFolder;
+
+	uint32 Revision = 0;
+	FOnChanged OnChangedPrivate;
+};
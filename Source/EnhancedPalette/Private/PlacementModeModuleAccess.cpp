@@ -8,6 +8,7 @@
 #include "PrivateAccessHelper.h"
 #include "EnhancedPaletteGlobals.h"
 #include "EnhancedPaletteSettings.h"
+#include "EnhancedPaletteModule.h"
 #include "Misc/NamePermissionList.h"
 #include "LevelEditor.h"
 #include "TutorialMetaData.h"
@@ -51,8 +52,10 @@ UE_DEFINE_PRIVATE_MEMBER_PTR(FOnPlacementModeCategoryListChanged, GFOnPlacementM
 #if UE_VERSION_NEWER_THAN_OR_EQUAL(5, 5, 0)
 using FCategoryContentBuilderPtr = TSharedPtr<FCategoryDrivenContentBuilder>;
 UE_DEFINE_PRIVATE_MEMBER_PTR(FCategoryContentBuilderPtr, GToolsCategoryContentBuilder, SPlacementModeTools, CategoryContentBuilder);
+UE_DEFINE_PRIVATE_MEMBER_PTR(FName, GBuilderActiveCategoryName, FCategoryDrivenContentBuilderBase, ActiveCategoryName);
 #else
 UE_DEFINE_PRIVATE_MEMBER_PTR(bool, GUpdateShownItems, SPlacementModeTools, bUpdateShownItems);
+UE_DEFINE_PRIVATE_MEMBER_PTR(FName, GToolsActiveTabName, SPlacementModeTools, ActiveTabName);
 #endif
 
 using FRecentListArray = TArray<FActorPlacementInfo>;
@@ -126,41 +129,158 @@ void FPlacementModeModuleAccess::NotifyAssetsChanged()
 	GetImpl().OnAllPlaceableAssetsChanged().Broadcast();
 }
 
+bool FPlacementModeModuleAccess::RegisterPlaceableItems(FName InCategory, TConstArrayView<TSharedRef<FPlaceableItem>> InItems, TArray<FPlacementModeID>& OutIds, bool bNotify)
+{
+	EPP_TRACE_SCOPE(EnhancedPalette_RegisterItems);
+
+	OutIds.Reset();
+
+	// mirrors FPlacementModeModule::RegisterPlaceableItem without per-item broadcast
+	FPlacementCategory* Category = (GetImpl().*GCategories).Find(InCategory);
+	if (!Category || Category->CustomGenerator)
+	{
+		return false;
+	}
+
+	OutIds.Reserve(InItems.Num());
+	Category->Items.Reserve(Category->Items.Num() + InItems.Num());
+
+	for (const TSharedRef<FPlaceableItem>& Item : InItems)
+	{
+		FPlacementModeID& Id = OutIds.AddDefaulted_GetRef();
+		Id.Category = InCategory;
+		Id.UniqueId = FGuid::NewGuid();
+		Category->Items.Add(Id.UniqueId, Item);
+	}
+
+	if (bNotify && InItems.Num())
+	{
+		NotifyCategoryRefreshed(InCategory);
+	}
+	return true;
+}
+
+void FPlacementModeModuleAccess::UnregisterPlaceableItems(TConstArrayView<FPlacementModeID> InIds, bool bNotify)
+{
+	EPP_TRACE_SCOPE(EnhancedPalette_UnregisterItems);
+
+	PlacementCategoryMap& Categories = GetImpl().*GCategories;
+
+	TArray<FName, TInlineAllocator<4>> Affected;
+
+	FName LastCategoryName = NAME_None;
+	FPlacementCategory* LastCategory = nullptr;
+	for (const FPlacementModeID& Id : InIds)
+	{
+		// ids usually come grouped by category
+		if (!LastCategory || Id.Category != LastCategoryName)
+		{
+			LastCategoryName = Id.Category;
+			LastCategory = Categories.Find(Id.Category);
+		}
+
+		if (LastCategory && LastCategory->Items.Remove(Id.UniqueId) > 0)
+		{
+			Affected.AddUnique(Id.Category);
+		}
+	}
+
+	if (bNotify)
+	{
+		for (const FName& Category : Affected)
+		{
+			NotifyCategoryRefreshed(Category);
+		}
+	}
+}
+
+/**
+ * Recent list entry identity used for lookups
+ */
+struct FRecentEntryKey
+{
+	const FString& Factory;
+	const FString& ObjectPath;
+	uint32 Hash;
+
+	FRecentEntryKey(const FString& InFactory, const FString& InObjectPath)
+		: Factory(InFactory), ObjectPath(InObjectPath), Hash(FPlacementModeModuleAccess::HashRecentEntry(InFactory, InObjectPath))
+	{
+	}
+
+	bool operator==(const FRecentEntryKey& Other) const
+	{
+		return Hash == Other.Hash && Factory == Other.Factory && ObjectPath == Other.ObjectPath;
+	}
+
+	friend uint32 GetTypeHash(const FRecentEntryKey& Key) { return Key.Hash; }
+};
+
+uint32 FPlacementModeModuleAccess::HashRecentEntry(const FString& Factory, const FString& ObjectPath)
+{
+	return HashCombineFast(GetTypeHash(Factory), GetTypeHash(ObjectPath));
+}
+
 void FPlacementModeModuleAccess::SetRecentList(const TArray<FConfigActorPlacementInfo>& NewList)
 {
+	EPP_TRACE_SCOPE(EnhancedPalette_SetRecentList);
+
 	// There are only two options - new list will have some element removed or have no elements at all
 	TArray<FActorPlacementInfo>& RecentlyPlaced = GetImpl().*GRecentlyPlaced;
 
-	TArray<FString> RecentlyPlacedAsStrings;
+	bool bChanged = false;
 
 	if (NewList.IsEmpty()) // user clicked to clear recent list
 	{
+		bChanged = !RecentlyPlaced.IsEmpty();
 		RecentlyPlaced.Reset();
 	}
 	else // some entries were removed
 	{
-		for (auto It = RecentlyPlaced.CreateIterator(); It; ++It)
+		TSet<FRecentEntryKey> Remaining;
+		Remaining.Reserve(NewList.Num());
+		for (const FConfigActorPlacementInfo& Elem : NewList)
 		{
-			const FActorPlacementInfo& Info = *It;
+			Remaining.Emplace(Elem.Factory, Elem.ObjectPath);
+		}
 
-			bool bRemain = NewList.FindByPredicate([&Info](const FConfigActorPlacementInfo& Elem)
-			{
-				return Elem.Factory == Info.Factory && Elem.ObjectPath == Info.ObjectPath;
-			}) != nullptr;
+		const int32 NumRemoved = RecentlyPlaced.RemoveAll([&Remaining](const FActorPlacementInfo& Info)
+		{
+			return !Remaining.Contains(FRecentEntryKey(Info.Factory, Info.ObjectPath));
+		});
+		bChanged = NumRemoved > 0;
+	}
 
-			if (!bRemain)
-			{
-				It.RemoveCurrent();
-				continue;
-			}
+	if (bChanged)
+	{
+		// config write is batched and performed later
+		bRecentListConfigDirty = true;
+		RecentListDirtyTime = FPlatformTime::Seconds();
 
-			RecentlyPlacedAsStrings.Add(Info.ToString());
-		}
+		GetImpl().OnRecentlyPlacedChanged().Broadcast(RecentlyPlaced);
 	}
+}
 
-	GConfig->SetArray(TEXT("PlacementMode"), TEXT("RecentlyPlaced"), RecentlyPlacedAsStrings, GEditorPerProjectIni);
+void FPlacementModeModuleAccess::FlushPendingConfig(bool bImmediate)
+{
+	// time for recent list edits to settle before writing config
+	constexpr double RecentListSettleDelay = 1.0;
 
-	GetImpl().OnRecentlyPlacedChanged().Broadcast(RecentlyPlaced);
+	if (!bRecentListConfigDirty)
+		return;
+	if (!bImmediate && FPlatformTime::Seconds() - RecentListDirtyTime < RecentListSettleDelay)
+		return;
+
+	bRecentListConfigDirty = false;
+
+	// list is short, formatting it is cheaper than handing it off to another thread
+	TArray<FString> RecentlyPlacedAsStrings;
+	RecentlyPlacedAsStrings.Reserve((GetImpl().*GRecentlyPlaced).Num());
+	for (const FActorPlacementInfo& Info : GetImpl().*GRecentlyPlaced)
+	{
+		RecentlyPlacedAsStrings.Add(Info.ToString());
+	}
+	GConfig->SetArray(TEXT("PlacementMode"), TEXT("RecentlyPlaced"), RecentlyPlacedAsStrings, GEditorPerProjectIni);
 }
 
 TSharedPtr<SWidget> FPlacementModeModuleAccess::TryDiscoverToolWidget()
@@ -174,6 +294,7 @@ TSharedPtr<SWidget> FPlacementModeModuleAccess::TryDiscoverToolWidget()
 			TSharedRef<SWidget> Widget = DockTab->GetContent();
 			checkf(Widget->GetType() == "SPlacementModeTools", TEXT("Must be of a PB type"));
 			PlacementBrowserToolbarWidget = Widget;
+			PlacementBrowserTab = DockTab;
 			return Widget;
 		}
 	}
@@ -182,6 +303,8 @@ TSharedPtr<SWidget> FPlacementModeModuleAccess::TryDiscoverToolWidget()
 
 void FPlacementModeModuleAccess::TryForceToolbarRefresh()
 {
+	EPP_TRACE_SCOPE(EnhancedPalette_ForceToolbarRefresh);
+
 	// epic does not refresh toolbar properly after initial populate, so new/changed things do not reflect
 	// to fix that need to locate the PlacementMode widget and
 	if (auto Widget = TryDiscoverToolWidget())
@@ -197,6 +320,8 @@ void FPlacementModeModuleAccess::TryForceToolbarRefresh()
 
 void FPlacementModeModuleAccess::TryForceContentRefresh()
 {
+	EPP_TRACE_SCOPE(EnhancedPalette_ForceContentRefresh);
+
 	// epic does not refresh content properly when category is being selected, so need to
 	if (auto Widget = TryDiscoverToolWidget())
 	{
@@ -210,3 +335,31 @@ void FPlacementModeModuleAccess::TryForceContentRefresh()
 #endif
 	}
 }
+
+bool FPlacementModeModuleAccess::IsToolWidgetShown()
+{
+	if (TryDiscoverToolWidget().IsValid())
+	{
+		TSharedPtr<SDockTab> DockTab = PlacementBrowserTab.Pin();
+		return DockTab.IsValid() && DockTab->IsForeground();
+	}
+	return false;
+}
+
+FName FPlacementModeModuleAccess::TryGetActiveCategory()
+{
+	if (auto Widget = TryDiscoverToolWidget())
+	{
+		TSharedRef<SPlacementModeTools> ToolsWidgetPrivate = StaticCastSharedRef<SPlacementModeTools>(Widget.ToSharedRef());
+#if UE_VERSION_NEWER_THAN_OR_EQUAL(5, 5, 0)
+		if (FCategoryContentBuilderPtr ToolsBuilderPrivate = (*ToolsWidgetPrivate).*GToolsCategoryContentBuilder)
+		{
+			FCategoryDrivenContentBuilderBase& BuilderBase = *ToolsBuilderPrivate;
+			return BuilderBase.*GBuilderActiveCategoryName;
+		}
+#else
+		return (*ToolsWidgetPrivate).*GToolsActiveTabName;
+#endif
+	}
+	return NAME_None;
+}
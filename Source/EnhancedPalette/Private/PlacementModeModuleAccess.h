@@ -44,16 +44,49 @@ public:
 	void NotifyRecentChanged();
 	void NotifyAssetsChanged();
 
+	/**
+	 * Register multiple placeable items within category as a single operation.
+	 * Unlike IPlacementModeModule::RegisterPlaceableItem broadcasts category refresh once (if requested).
+	 * @param InCategory category to register items in
+	 * @param InItems items to register
+	 * @param OutIds ids of registered items in the same order as input
+	 * @param bNotify broadcast category refresh after registration
+	 * @return true if category accepted items
+	 */
+	bool RegisterPlaceableItems(FName InCategory, TConstArrayView<TSharedRef<FPlaceableItem>> InItems, TArray<FPlacementModeID>& OutIds, bool bNotify = true);
+
+	/**
+	 * Unregister multiple placeable items as a single operation.
+	 * Unlike IPlacementModeModule::UnregisterPlaceableItem broadcasts category refresh once per affected category (if requested).
+	 */
+	void UnregisterPlaceableItems(TConstArrayView<FPlacementModeID> InIds, bool bNotify = true);
+
 	void SetRecentList(const TArray<FConfigActorPlacementInfo>& NewList);
 
+	// Hash of recent list entry identity
+	static uint32 HashRecentEntry(const FString& Factory, const FString& ObjectPath);
+
+	// Write pending recent list changes to config once they settle. Immediate flush ignores the settle delay.
+	void FlushPendingConfig(bool bImmediate = false);
+
 	// @hack for 5.5+
 	TSharedPtr<SWidget> TryDiscoverToolWidget();
 	void TryForceToolbarRefresh();
 	void TryForceContentRefresh();
+	// Get category currently shown by placement browser, None if browser is not open
+	FName TryGetActiveCategory();
+	// Is placement browser tab open and in foreground
+	bool IsToolWidgetShown();
 
 private:
 	IPlacementModeModule* Impl = nullptr;
 	struct FriendlyPM& GetImpl() const;
 
 	TWeakPtr<SWidget> PlacementBrowserToolbarWidget;
+	TWeakPtr<class SDockTab> PlacementBrowserTab;
+
+	// recent list config write is pending
+	bool bRecentListConfigDirty = false;
+	// time of the last recent list change
+	double RecentListDirtyTime = 0;
 };
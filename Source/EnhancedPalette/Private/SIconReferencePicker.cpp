@@ -0,0 +1,168 @@
+﻿// Copyright 2025, Aquanox.
+
+#include "SIconReferencePicker.h"
+
+#include "Styling/AppStyle.h"
+#include "Widgets/Images/SImage.h"
+#include "Widgets/Input/SComboButton.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Text/STextBlock.h"
+
+void SIconReferencePicker::Construct(const FArguments& InArgs)
+{
+	OnIconSelected = InArgs._OnIconSelected;
+	MaxListHeight = InArgs._MaxListHeight;
+
+	ChildSlot
+	[
+		SAssignNew(ComboButton, SComboButton)
+		.OnGetMenuContent(this, &SIconReferencePicker::OnGetMenuContent)
+		.OnMenuOpenChanged(this, &SIconReferencePicker::OnMenuOpenChanged)
+		.ButtonContent()
+		[
+			SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(2, 2, 6, 2)
+			[
+				SNew(SImage).Image(InArgs._SelectedIcon).DesiredSizeOverride(FVector2D(20, 20))
+			]
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.f)
+			.HAlign(HAlign_Fill)
+			.VAlign(VAlign_Center)
+			[
+				SNew(STextBlock).Font(FAppStyle::GetFontStyle(TEXT("PropertyWindow.NormalFont"))).Text(InArgs._SelectedText)
+			]
+		]
+	];
+}
+
+TSharedRef<SWidget> SIconReferencePicker::OnGetMenuContent()
+{
+	Catalog = FIconCatalog::Get();
+	RefreshFilter();
+	if (!Catalog->IsComplete() && !CatalogTimer.IsValid())
+	{
+		CatalogTimer = RegisterActiveTimer(0.f, FWidgetActiveTimerDelegate::CreateSP(this, &SIconReferencePicker::UpdateCatalog));
+	}
+
+	TSharedRef<SWidget> MenuContent = SNew(SVerticalBox)
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(2)
+		[
+			SAssignNew(SearchBox, SSearchBox)
+			.InitialText(FText::FromString(FilterText))
+			.OnTextChanged(this, &SIconReferencePicker::OnFilterTextChanged)
+			.OnTextCommitted(this, &SIconReferencePicker::OnFilterTextCommitted)
+		]
+		+ SVerticalBox::Slot()
+		.FillHeight(1.f)
+		[
+			SNew(SBox)
+			.MaxDesiredHeight(MaxListHeight)
+			[
+				SAssignNew(ListView, SListView<FIconCatalogEntryPtr>)
+				.ListItemsSource(&FilteredEntries)
+				.OnGenerateRow(this, &SIconReferencePicker::OnGenerateRow)
+				.OnSelectionChanged(this, &SIconReferencePicker::OnSelectionChanged)
+				.SelectionMode(ESelectionMode::Single)
+			]
+		];
+
+	ComboButton->SetMenuContentWidgetToFocus(SearchBox);
+	return MenuContent;
+}
+
+void SIconReferencePicker::OnMenuOpenChanged(bool bOpen)
+{
+	if (!bOpen)
+	{
+		// release list and catalog snapshot while closed
+		FilteredEntries.Empty();
+		Catalog.Reset();
+	}
+}
+
+EActiveTimerReturnType SIconReferencePicker::UpdateCatalog(double InCurrentTime, float InDeltaTime)
+{
+	if (!Catalog.IsValid())
+	{
+		// menu closed
+		return EActiveTimerReturnType::Stop;
+	}
+
+	TSharedRef<const FIconCatalog> Current = FIconCatalog::Get();
+	if (Current != Catalog.ToSharedRef())
+	{
+		Catalog = Current;
+		RefreshFilter();
+	}
+	return Catalog->IsComplete() ? EActiveTimerReturnType::Stop : EActiveTimerReturnType::Continue;
+}
+
+void SIconReferencePicker::OnFilterTextChanged(const FText& InText)
+{
+	FilterText = InText.ToString();
+	RefreshFilter();
+}
+
+void SIconReferencePicker::OnFilterTextCommitted(const FText& InText, ETextCommit::Type InCommitType)
+{
+	if (InCommitType == ETextCommit::OnEnter && FilteredEntries.Num())
+	{
+		OnSelectionChanged(FilteredEntries[0], ESelectInfo::OnKeyPress);
+	}
+}
+
+void SIconReferencePicker::RefreshFilter()
+{
+	if (Catalog.IsValid())
+	{
+		Catalog->Search(FilterText, FilteredEntries);
+	}
+
+	if (ListView.IsValid())
+	{
+		ListView->RequestListRefresh();
+		if (FilteredEntries.Num())
+		{
+			ListView->RequestScrollIntoView(FilteredEntries[0]);
+		}
+	}
+}
+
+TSharedRef<ITableRow> SIconReferencePicker::OnGenerateRow(FIconCatalogEntryPtr InEntry, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(STableRow<FIconCatalogEntryPtr>, OwnerTable)
+	[
+		SNew(SHorizontalBox)
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		.Padding(2, 2, 6, 2)
+		[
+			SNew(SImage).Image(InEntry->Icon.GetBrush()).DesiredSizeOverride(FVector2D(20, 20))
+		]
+		+ SHorizontalBox::Slot()
+		.FillWidth(1.f)
+		.HAlign(HAlign_Fill)
+		.VAlign(VAlign_Center)
+		[
+			SNew(STextBlock).Font(FAppStyle::GetFontStyle(TEXT("PropertyWindow.NormalFont"))).Text(InEntry->Icon.GetDisplayText())
+		]
+	];
+}
+
+void SIconReferencePicker::OnSelectionChanged(FIconCatalogEntryPtr InEntry, ESelectInfo::Type InSelectInfo)
+{
+	// navigation within list should not apply selection
+	if (!InEntry.IsValid() || InSelectInfo == ESelectInfo::OnNavigation || InSelectInfo == ESelectInfo::Direct)
+	{
+		return;
+	}
+
+	OnIconSelected.ExecuteIfBound(InEntry->Icon);
+	ComboButton->SetIsOpen(false);
+}
@@ -0,0 +1,54 @@
+﻿// Copyright 2025, Aquanox.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IconCatalog.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+
+class SComboButton;
+class SSearchBox;
+
+/**
+ * Dropdown picker over icon catalog with fuzzy search
+ */
+class SIconReferencePicker : public SCompoundWidget
+{
+public:
+	DECLARE_DELEGATE_OneParam(FOnIconSelected, const FSimpleIconReference&);
+
+	SLATE_BEGIN_ARGS(SIconReferencePicker)
+		: _MaxListHeight(450.f)
+	{}
+		SLATE_ATTRIBUTE(const FSlateBrush*, SelectedIcon)
+		SLATE_ATTRIBUTE(FText, SelectedText)
+		SLATE_ARGUMENT(float, MaxListHeight)
+		SLATE_EVENT(FOnIconSelected, OnIconSelected)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+private:
+	TSharedRef<SWidget> OnGetMenuContent();
+	void OnMenuOpenChanged(bool bOpen);
+	void OnFilterTextChanged(const FText& InText);
+	void OnFilterTextCommitted(const FText& InText, ETextCommit::Type InCommitType);
+	TSharedRef<ITableRow> OnGenerateRow(FIconCatalogEntryPtr InEntry, const TSharedRef<STableViewBase>& OwnerTable);
+	void OnSelectionChanged(FIconCatalogEntryPtr InEntry, ESelectInfo::Type InSelectInfo);
+	void RefreshFilter();
+	EActiveTimerReturnType UpdateCatalog(double InCurrentTime, float InDeltaTime);
+
+	FOnIconSelected OnIconSelected;
+	float MaxListHeight = 450.f;
+
+	TSharedPtr<SComboButton> ComboButton;
+	TSharedPtr<SSearchBox> SearchBox;
+	TSharedPtr<SListView<FIconCatalogEntryPtr>> ListView;
+
+	// catalog snapshot used while menu is open, replaced by later snapshots until complete
+	TSharedPtr<const FIconCatalog> Catalog;
+	TWeakPtr<FActiveTimerHandle> CatalogTimer;
+	FString FilterText;
+	TArray<FIconCatalogEntryPtr> FilteredEntries;
+};
@@ -7,6 +7,7 @@
 #include "ActorFactories/ActorFactoryCharacter.h"
 #include "ActorFactories/ActorFactoryPawn.h"
 #include "AssetRegistry/IAssetRegistry.h"
+#include "EnhancedPaletteLibrary.h"
 #include "GameFramework/Pawn.h"
 #include "Subsystems/PlacementSubsystem.h"
 
@@ -16,6 +17,7 @@ namespace FeatureSwitches
 {
 	constexpr bool bRegisterPeriodicUpdate = false;
 	constexpr bool bRegisterDelegates = false;
+	constexpr bool bTrackWorldChanges = false;
 }
 
 UExampleNativeCategory::UExampleNativeCategory()
@@ -30,6 +32,12 @@ UExampleNativeCategory::UExampleNativeCategory()
 		bTickable = true;
 		TickInterval = 10.f;
 	}
+
+	// can regather when level actors are placed or deleted, needed by most used classes example
+	if (FeatureSwitches::bTrackWorldChanges)
+	{
+		bTrackingWorldChanges = true;
+	}
 }
 
 void UExampleNativeCategory::NativeInitialize()
@@ -62,6 +70,12 @@ void UExampleNativeCategory::NativeGatherItems()
 	ExampleGatherBlueprintsOfClass();
 
 	ExampleGatherAssetsOfClass();
+
+	// level content is only listed when category is regathered on world changes, otherwise it goes stale
+	if (FeatureSwitches::bTrackWorldChanges)
+	{
+		ExampleGatherMostUsedInLevel();
+	}
 }
 
 void UExampleNativeCategory::ExampleGatherExplicit()
@@ -146,28 +160,70 @@ void UExampleNativeCategory::ExampleGatherBlueprintsOfClass()
 	});
 }
 
+/**
+ * Declaring the asset search filter instead of enumerating registry directly.
+ * Subsystem merges filters of all categories gathering at the same time and enumerates registry once.
+ */
+bool UExampleNativeCategory::NativeBeginSharedEnumeration(FARFilter& OutFilter)
+{
+	SharedAssets.Reset();
+
+	// Build the asset search filter with some parameters
+	OutFilter.ClassPaths.Add(UStaticMesh::StaticClass()->GetClassPathName());
+	OutFilter.PackagePaths.Add(TEXT("/Engine/EngineMeshes"));
+	OutFilter.TagsAndValues.Add(TEXT("NaniteEnabled"), TOptional<FString>(TEXT("False")));
+	OutFilter.bIncludeOnlyOnDiskAssets = true;
+	return true;
+}
+
+void UExampleNativeCategory::NativeReceiveSharedAsset(const FAssetData& InAsset)
+{
+	SharedAssets.Add(InAsset);
+}
+
+void UExampleNativeCategory::NativeDiscardSharedEnumeration()
+{
+	SharedAssets.Reset();
+}
+
 void UExampleNativeCategory::ExampleGatherAssetsOfClass()
 {
 	// Since this example searches for meshes to spawn - can already pinpoint desired factory type
 	auto SMAFactory = GEditor->GetEditorSubsystem<UPlacementSubsystem>()
 							 ->GetAssetFactoryFromFactoryClass(UActorFactoryStaticMesh::StaticClass());
-	
-	// Build the asset search filter with some parameters
-	FARFilter Filter;
-	Filter.ClassPaths.Add(UStaticMesh::StaticClass()->GetClassPathName());
-	Filter.PackagePaths.Add(TEXT("/Engine/EngineMeshes"));
-	Filter.TagsAndValues.Add(TEXT("NaniteEnabled"), TOptional<FString>(TEXT("False")));
-	Filter.bIncludeOnlyOnDiskAssets = true;
 
-	// Enumerate all assets matching filter and add them
-	IAssetRegistry::GetChecked().EnumerateAssets(Filter, [&](const FAssetData& Asset)
+	// Add all assets matching filter declared in NativeBeginSharedEnumeration
+	for (const FAssetData& Asset : SharedAssets)
 	{
 		auto Item = MakeShared<FPlaceableItem>(SMAFactory, Asset, TOptional<int32>(20));
 		Item->NativeName = FString("GA_") + Item->NativeName;
 		Item->DisplayName = FText::FromString(FString("GA_") + Item->DisplayName.ToString());
 		AddPlaceableItemPtr(Item);
-		return true;
-	});
+	}
+	SharedAssets.Reset();
+}
+
+/**
+ * Listing actor classes most used in currently edited level.
+ * Only gathered with bTrackWorldChanges feature switch enabled.
+ */
+void UExampleNativeCategory::ExampleGatherMostUsedInLevel()
+{
+	constexpr int32 MaxItems = 10;
+	int32 NumAdded = 0;
+
+	// World index is maintained by subsystem, query does not iterate level actors
+	for (const FPaletteClassUsage& Usage : UEnhancedPaletteLibrary::GetMostUsedLevelActorClasses(0))
+	{
+		// skip bookkeeping actors every level has, such as world settings or brushes
+		UClass* Class = Usage.Class.Get();
+		if (!Class || Class->HasAnyClassFlags(CLASS_NotPlaceable | CLASS_Abstract))
+			continue;
+
+		AddActorClass(Class, NAME_None, FText::Format(INVTEXT("{0} ({1})"), Class->GetDisplayNameText(), Usage.Count));
+		if (++NumAdded == MaxItems)
+			break;
+	}
 }
 
 void UExampleNativeCategory::ExampleCustomItemType()
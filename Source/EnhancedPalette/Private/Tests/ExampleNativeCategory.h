@@ -30,10 +30,20 @@ public:
      * Invoked every time when category content refreshes 
      */	
 	virtual void NativeGatherItems() override;
+    /**
+     * Invoked before gather to declare assets of interest, subsystem enumerates registry once for all categories
+     */
+	virtual bool NativeBeginSharedEnumeration(FARFilter& OutFilter) override;
+	virtual void NativeReceiveSharedAsset(const FAssetData& InAsset) override;
+	virtual void NativeDiscardSharedEnumeration() override;
 
 private:
 	void ExampleGatherExplicit();
 	void ExampleGatherBlueprintsOfClass();
 	void ExampleGatherAssetsOfClass();
+	void ExampleGatherMostUsedInLevel();
 	void ExampleCustomItemType();
+
+	// assets received from shared enumeration for current gather
+	TArray<FAssetData> SharedAssets;
 };
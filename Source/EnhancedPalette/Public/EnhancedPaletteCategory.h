@@ -5,11 +5,39 @@
 #include "EnhancedPaletteGlobals.h"
 #include "EnhancedPaletteSettings.h"
 #include "IPlacementModeModule.h"
+#include "Engine/EngineTypes.h"
+#include "AssetRegistry/ARFilter.h"
+#include <atomic>
 #include "EnhancedPaletteCategory.generated.h"
 
 class UEnhancedPaletteSubsystem;
 enum class EManagedCategoryDirtyFlags;
 
+/**
+ * Cancellation token of a running gather.
+ *
+ * Gather is cancelled once its category is dirtied again, results of it are stale and are discarded by subsystem.
+ * Counter is thread safe, so token can be checked by gather work running outside of game thread.
+ */
+struct FPaletteGatherToken
+{
+	using FCounter = TSharedPtr<std::atomic<uint32>, ESPMode::ThreadSafe>;
+
+	FPaletteGatherToken() = default;
+	explicit FPaletteGatherToken(const FCounter& InCounter)
+		: Counter(InCounter), Generation(InCounter.IsValid() ? InCounter->load() : 0)
+	{
+	}
+
+	// Generation of category content gather was started for
+	uint32 GetGeneration() const { return Generation; }
+	bool IsCancelled() const { return Counter.IsValid() && Counter->load(std::memory_order_relaxed) != Generation; }
+
+private:
+	FCounter Counter;
+	uint32 Generation = 0;
+};
+
 /**
  * Base class for palette categories.
  *
@@ -60,18 +88,41 @@ public:
 	// Should category listen to blueprint changes
 	UPROPERTY(EditAnywhere, Category="PaletteCategory|Tracking")
 	bool bTrackingBlueprintChanges = false;
+	// Only blueprints derived from these classes affect category content. Empty to react to any blueprint
+	UPROPERTY(EditAnywhere, Category="PaletteCategory|Tracking", meta=(EditCondition="bTrackingBlueprintChanges", AllowAbstract))
+	TArray<TSoftClassPtr<UObject>> BlueprintBaseClasses;
+	// Only blueprints within these folders affect category content. Empty to react to any location
+	UPROPERTY(EditAnywhere, Category="PaletteCategory|Tracking", meta=(EditCondition="bTrackingBlueprintChanges", ContentDir))
+	TArray<FDirectoryPath> BlueprintPaths;
 	// Should category listen to asset changes
 	UPROPERTY(EditAnywhere, Category="PaletteCategory|Tracking")
 	bool bTrackingAssetChanges = false;
 	// Should category listen to world changes
 	UPROPERTY(EditAnywhere, Category="PaletteCategory|Tracking")
 	bool bTrackingWorldChanges = false;
+	// Asset registry tags indexed by subsystem for lookup by value during gather (see GetAssetsByTagValue)
+	UPROPERTY(EditAnywhere, Category="PaletteCategory|Tracking")
+	TArray<FName> IndexedAssetTags;
+	// Should category content be updated while Place Actors panel is closed (e.g. when it is used by other tools)
+	UPROPERTY(EditAnywhere, Category="PaletteCategory|Tracking")
+	bool bKeepUpdatedWhileHidden = false;
+
+	// Gather time budget of this category. 0 = use project setting
+	UPROPERTY(EditAnywhere, Category="PaletteCategory|Budget", meta=(ClampMin=0, Units="ms"))
+	float GatherTimeBudgetMs = 0.f;
+	// Update time budget of this category. 0 = use project setting
+	UPROPERTY(EditAnywhere, Category="PaletteCategory|Budget", meta=(ClampMin=0, Units="ms"))
+	float TickTimeBudgetMs = 0.f;
+	// Item count budget of this category. 0 = use project setting
+	UPROPERTY(EditAnywhere, Category="PaletteCategory|Budget", meta=(ClampMin=0))
+	int32 ItemCountBudget = 0;
 
 private:
 	UPROPERTY(Transient)
 	TArray<TInstancedStruct<FConfigPlaceableItem>> LocalDescriptors;
 
 	bool bGathering = false;
+	FPaletteGatherToken GatherToken;
 	TOptional<int32> AutoOrder;
 	float Accumulator = 0.f;
 
@@ -86,6 +137,8 @@ public:
 	virtual bool IsSortable() const { return bSortable; }
 	virtual FString GetTagMetaData() const;
 	virtual int32 GetSortOrder() const { return SortOrder; }
+	// Asset registry tags category needs to be indexed by value
+	virtual void GetIndexedAssetTags(TArray<FName>& OutTags) const { OutTags.Append(IndexedAssetTags); }
 
 	/**
  	 *
@@ -98,9 +151,9 @@ public:
 	void K2_Initialize();
 
 	/**
-	 *
+	 * Returns true if update interval elapsed and category was updated
 	 */
-	void Tick(float DeltaTime);
+	bool Tick(float DeltaTime);
 
 	virtual void NativeTick();
 
@@ -110,13 +163,27 @@ public:
 	/**
 	 * The data collection entry pointer
 	 */
-	void GatherItems(TArray<TConfigPlaceableItem>& OutResult);
+	void GatherItems(TArray<TConfigPlaceableItem>& OutResult, const FPaletteGatherToken& InToken = FPaletteGatherToken());
 
 	virtual void NativeGatherItems();
 
 	UFUNCTION(BlueprintImplementableEvent, Category=EnhancedPalette, meta=(DisplayName="Gather Items"))
 	void K2_GatherItems();
 
+	/**
+	 * Invoked before gather to declare asset registry filter for shared enumeration.
+	 * Subsystem merges filters of all categories about to gather and enumerates registry once,
+	 * assets included by declared filter are passed to NativeReceiveSharedAsset before NativeGatherItems.
+	 * @return true to take part in shared enumeration
+	 */
+	virtual bool NativeBeginSharedEnumeration(FARFilter& OutFilter) { return false; }
+	// Invoked for each asset included by filter declared in NativeBeginSharedEnumeration
+	virtual void NativeReceiveSharedAsset(const FAssetData& InAsset) { }
+	// Invoked once shared enumeration is over
+	virtual void NativeEndSharedEnumeration() { }
+	// Invoked when category changed after shared enumeration but before gather, received assets are outdated
+	virtual void NativeDiscardSharedEnumeration() { }
+
 	/**
 	 * Add native type descriptor (constructs FPlaceableItem)
 	 */
@@ -259,6 +326,13 @@ public:
 		meta=( BlueprintProtected=true))
 	void NotifyContentChanged();
 
+	/**
+	 * Check whether category was dirtied again while gathering.
+	 * Long gathers should check it periodically and stop, further added items are ignored.
+	 */
+	UFUNCTION(BlueprintPure, Category=EnhancedPalette, meta=(BlueprintProtected=true))
+	bool IsGatherCancelled() const;
+
 	/**
 	 * Sort currently collected items in local container
 	 */
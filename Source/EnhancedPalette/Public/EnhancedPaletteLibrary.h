@@ -3,12 +3,14 @@
 #pragma once
 
 #include "EnhancedPaletteGlobals.h"
+#include "EnhancedPaletteTypes.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "GameFramework/Actor.h"
 #include "ActorFactories/ActorFactory.h"
 #include "EnhancedPaletteLibrary.generated.h"
 
 struct FConfigPlaceableItem;
+class UEnhancedPalettePopulateAction;
 
 /**
  * Variety of editor functions for collectors
@@ -25,6 +27,25 @@ public:
 	UFUNCTION(BlueprintCallable, Category="EnhancedPalette|Misc")
 	static void RequestPopulateCategories();
 
+	/**
+	 * Repopulate categories and return handle that completes when populate is done.
+	 * Meant for scripts, bind to Completed/TimedOut of returned handle or poll IsFinished.
+	 * @param Categories categories to repopulate, all categories if empty
+	 * @param bDiscover run category discovery before populate
+	 * @param TimeoutSeconds time to wait before giving up, 0 to wait indefinitely
+	 */
+	UFUNCTION(BlueprintCallable, Category="EnhancedPalette|Misc", meta=(AutoCreateRefTerm="Categories"))
+	static UEnhancedPalettePopulateAction* StartPopulateCategories(const TArray<FName>& Categories, bool bDiscover = false, float TimeoutSeconds = 30.f);
+
+	/**
+	 * Search items registered by palette categories by display name, native name or object path.
+	 * Queries of 3+ characters match any substring, shorter queries only match at word starts.
+	 * @param Query search string, case-insensitive
+	 * @param MaxResults maximum number of results, 0 for unlimited
+	 */
+	UFUNCTION(BlueprintCallable, Category="EnhancedPalette|Misc")
+	static TArray<FPaletteSearchResult> SearchPlaceableItems(const FString& Query, int32 MaxResults = 50);
+
 	UFUNCTION(BlueprintCallable, DisplayName="Register Placement Category", Category="EnhancedPalette|Externals")
 	static bool RegisterExternalCategory(FName UniqueId,
 		UPARAM(DisplayName=Tooltip) FText DisplayName,
@@ -33,6 +54,13 @@ public:
 		int32 SortOrder = 0,
 		bool bSortable = true);
 
+	/**
+	 * Register multiple placement categories with a single discovery pass.
+	 * @return number of registered categories
+	 */
+	UFUNCTION(BlueprintCallable, DisplayName="Register Placement Categories", Category="EnhancedPalette|Externals")
+	static int32 RegisterExternalCategories(const TArray<FStaticPlacementCategoryInfo>& Categories);
+
 	UFUNCTION()
 	static TArray<FString> K2_IconSelectorHelper();
 
@@ -42,6 +70,64 @@ public:
 	UFUNCTION(BlueprintCallable, DisplayName="Register Placeable Item", Category="EnhancedPalette|Externals")
 	static bool AddCategoryPlaceableItem(FName UniqueId, TInstancedStruct<FConfigPlaceableItem> Descriptor);
 
+	/**
+	 * Append multiple items to category, only appended items are registered.
+	 * @return handles of added items in the same order, used to remove them later
+	 */
+	UFUNCTION(BlueprintCallable, DisplayName="Register Placeable Items", Category="EnhancedPalette|Externals")
+	static TArray<FGuid> AddCategoryPlaceableItems(FName UniqueId, const TArray<TInstancedStruct<FConfigPlaceableItem>>& Descriptors);
+
+	/**
+	 * Remove items from category by handles, only removed items are unregistered.
+	 * @return number of removed items
+	 */
+	UFUNCTION(BlueprintCallable, DisplayName="Unregister Placeable Items", Category="EnhancedPalette|Externals")
+	static int32 RemoveCategoryPlaceableItems(FName UniqueId, const TArray<FGuid>& Handles);
+
+	/**
+	 * Find actors of class within editor world using world index, without iterating all actors.
+	 */
+	UFUNCTION(BlueprintCallable, Category="EnhancedPalette|World")
+	static TArray<AActor*> GetLevelActorsOfClass(TSubclassOf<AActor> Class, bool bIncludeSubclasses = true);
+
+	/**
+	 * Find actors having tag within editor world using world index.
+	 */
+	UFUNCTION(BlueprintCallable, Category="EnhancedPalette|World")
+	static TArray<AActor*> GetLevelActorsWithTag(FName Tag);
+
+	/**
+	 * Find actors within outliner folder of editor world using world index.
+	 */
+	UFUNCTION(BlueprintCallable, Category="EnhancedPalette|World")
+	static TArray<AActor*> GetLevelActorsInFolder(FName Folder, bool bIncludeSubfolders = true);
+
+	/**
+	 * Number of actors of class within editor world.
+	 */
+	UFUNCTION(BlueprintCallable, Category="EnhancedPalette|World")
+	static int32 GetLevelActorClassUsage(TSubclassOf<AActor> Class, bool bIncludeSubclasses = false);
+
+	/**
+	 * Actor classes within editor world ordered by number of instances.
+	 * @param MaxResults maximum number of results, 0 for unlimited
+	 */
+	UFUNCTION(BlueprintCallable, Category="EnhancedPalette|World")
+	static TArray<FPaletteClassUsage> GetMostUsedLevelActorClasses(int32 MaxResults = 20);
+
+	/**
+	 * Find assets with asset registry tag value using subsystem tag index, without enumerating registry.
+	 * Tag must be declared in IndexedAssetTags of any palette category.
+	 */
+	UFUNCTION(BlueprintCallable, Category="EnhancedPalette|Assets")
+	static TArray<FAssetData> GetAssetsByTagValue(FName Tag, const FString& Value);
+
+	/**
+	 * Distinct values of asset registry tag declared in IndexedAssetTags of any palette category.
+	 */
+	UFUNCTION(BlueprintCallable, Category="EnhancedPalette|Assets")
+	static TArray<FString> GetIndexedTagValues(FName Tag);
+
 	UFUNCTION(BlueprintCallable, Category="EnhancedPalette|Misc", meta=(DefaultToSelf="Category", AdvancedDisplay=1))
 	static void NotifyCategoryChanged(UEnhancedPaletteCategory* Category, bool bContent = true, bool bInfo = false);
 
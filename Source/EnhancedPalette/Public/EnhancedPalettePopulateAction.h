@@ -0,0 +1,68 @@
+﻿// Copyright 2025, Aquanox.
+
+#pragma once
+
+#include "EnhancedPaletteTypes.h"
+#include "Containers/Ticker.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "EnhancedPalettePopulateAction.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPalettePopulateFinished, const TArray<FPaletteCategoryPopulateResult>&, Results);
+
+/**
+ * Requests palette categories to be repopulated and completes once subsystem has no pending populate work.
+ *
+ * Usable as latent node in editor blueprints, from python the action can be created with WaitForPopulate,
+ * bound to Completed/TimedOut and started with Activate.
+ */
+UCLASS()
+class ENHANCEDPALETTE_API UEnhancedPalettePopulateAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+public:
+	/**
+	 * Repopulate palette categories and wait until it is done.
+	 * @param Categories categories to repopulate, all categories if empty
+	 * @param bDiscover run category discovery before populate
+	 * @param TimeoutSeconds time to wait before giving up, 0 to wait indefinitely
+	 */
+	UFUNCTION(BlueprintCallable, Category="EnhancedPalette|Misc", meta=(BlueprintInternalUseOnly="true", AutoCreateRefTerm="Categories"))
+	static UEnhancedPalettePopulateAction* WaitForPopulate(const TArray<FName>& Categories, bool bDiscover = false, float TimeoutSeconds = 30.f);
+
+	// Called when requested categories were populated
+	UPROPERTY(BlueprintAssignable)
+	FOnPalettePopulateFinished Completed;
+
+	// Called when populate did not finish within timeout, contains categories populated so far
+	UPROPERTY(BlueprintAssignable)
+	FOnPalettePopulateFinished TimedOut;
+
+	virtual void Activate() override;
+
+	UFUNCTION(BlueprintPure, Category="EnhancedPalette|Misc")
+	bool IsFinished() const { return bFinished; }
+
+	UFUNCTION(BlueprintPure, Category="EnhancedPalette|Misc")
+	const TArray<FPaletteCategoryPopulateResult>& GetResults() const { return Results; }
+
+private:
+	void HandleCategoryPopulated(const FPaletteCategoryPopulateResult& Result);
+	void HandlePostTick(bool bIdle);
+	void Finish(bool bTimedOut);
+	// finish on next tick, so caller that just started the action can bind to it
+	void FinishDeferred(bool bTimedOut);
+
+	TArray<FName> Categories;
+	bool bDiscover = false;
+	float TimeoutSeconds = 0.f;
+
+	TArray<FPaletteCategoryPopulateResult> Results;
+	double StartTime = 0;
+	bool bFinished = false;
+
+	// populate keeps running while placement browser is hidden until action finishes
+	bool bHoldingForcedPopulate = false;
+
+	FDelegateHandle HandleOnCategoryPopulated;
+	FDelegateHandle HandleOnPostTick;
+};
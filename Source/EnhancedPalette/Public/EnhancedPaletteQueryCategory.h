@@ -0,0 +1,175 @@
+﻿// Copyright 2025, Aquanox.
+
+#pragma once
+
+#include "EnhancedPaletteCategory.h"
+#include "EnhancedPaletteQueryCategory.generated.h"
+
+UENUM()
+enum class EPaletteQueryTagOperation : uint8
+{
+	// Asset has tag with any value
+	Exists,
+	// Tag value equals to specified value (case-insensitive)
+	Equals,
+	// Asset does not have tag or its value differs
+	NotEquals,
+	// Tag value contains specified value (case-insensitive)
+	Contains,
+};
+
+/**
+ * Asset registry tag condition
+ */
+USTRUCT(BlueprintType)
+struct ENHANCEDPALETTE_API FPaletteQueryTagPredicate
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Query)
+	FName Tag;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Query)
+	EPaletteQueryTagOperation Operation = EPaletteQueryTagOperation::Equals;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Query, meta=(EditCondition="Operation != EPaletteQueryTagOperation::Exists"))
+	FString Value;
+
+	bool Matches(const FAssetData& InAsset) const;
+};
+
+UENUM()
+enum class EPaletteQuerySortRule : uint8
+{
+	// Leave order to palette
+	None,
+	// By display name
+	Name,
+	// By asset class name, then by display name
+	Class,
+	// By package path, then by display name
+	Path,
+	// By value of SortTag, then by display name
+	TagValue,
+};
+
+/**
+ * Category configured by declarative asset query.
+ *
+ * Query is evaluated natively against asset registry, no gather code is needed.
+ * After first evaluation the result is kept up to date from asset registry events,
+ * category content is refreshed only when an asset enters, leaves or changes within the result.
+ *
+ * Create a blueprint subclass and fill query properties in class defaults.
+ */
+UCLASS(Abstract, Blueprintable)
+class ENHANCEDPALETTE_API UEnhancedPaletteQueryCategory : public UEnhancedPaletteCategory
+{
+	GENERATED_BODY()
+
+public:
+	// Asset classes to include. Empty to include any class
+	UPROPERTY(EditAnywhere, Category="PaletteCategory|Query", meta=(AllowAbstract))
+	TArray<TSoftClassPtr<UObject>> AssetClasses;
+
+	// Include assets of classes derived from AssetClasses
+	UPROPERTY(EditAnywhere, Category="PaletteCategory|Query")
+	bool bIncludeSubclasses = true;
+
+	// Include only blueprints generating classes derived from these classes. Empty to skip the check
+	UPROPERTY(EditAnywhere, Category="PaletteCategory|Query", meta=(AllowAbstract))
+	TArray<TSoftClassPtr<UObject>> BlueprintParentClasses;
+
+	// Content folders to search. Empty to search everywhere
+	UPROPERTY(EditAnywhere, Category="PaletteCategory|Query", meta=(ContentDir))
+	TArray<FDirectoryPath> PackagePaths;
+
+	// Include assets within subfolders of PackagePaths
+	UPROPERTY(EditAnywhere, Category="PaletteCategory|Query")
+	bool bRecursivePaths = true;
+
+	// Conditions on asset registry tags, all of them must pass
+	UPROPERTY(EditAnywhere, Category="PaletteCategory|Query")
+	TArray<FPaletteQueryTagPredicate> TagPredicates;
+
+	// Actor factory used for found assets. Empty to detect automatically
+	UPROPERTY(EditAnywhere, Category="PaletteCategory|Query", meta=(MustImplement="/Script/EditorFramework.AssetFactoryInterface"))
+	TSoftClassPtr<UObject> FactoryOverride;
+
+	// Item display name. Supports {Name}, {Class}, {Folder} and {Tag:TagName} tokens
+	UPROPERTY(EditAnywhere, Category="PaletteCategory|Query")
+	FString DisplayNameFormat = TEXT("{Name}");
+
+	// Remove type prefix (e.g. SM_, BP_) from asset name used for {Name}
+	UPROPERTY(EditAnywhere, Category="PaletteCategory|Query")
+	bool bStripAssetPrefix = false;
+
+	UPROPERTY(EditAnywhere, Category="PaletteCategory|Query")
+	EPaletteQuerySortRule SortRule = EPaletteQuerySortRule::None;
+
+	UPROPERTY(EditAnywhere, Category="PaletteCategory|Query", meta=(EditCondition="SortRule == EPaletteQuerySortRule::TagValue"))
+	FName SortTag;
+
+	UPROPERTY(EditAnywhere, Category="PaletteCategory|Query", meta=(EditCondition="SortRule != EPaletteQuerySortRule::None"))
+	bool bSortDescending = false;
+
+	// Sort order assigned to first item, following items get consecutive values
+	UPROPERTY(EditAnywhere, Category="PaletteCategory|Query", meta=(EditCondition="SortRule != EPaletteQuerySortRule::None"))
+	int32 SortOrderStart = 0;
+
+public:
+	UEnhancedPaletteQueryCategory();
+
+	virtual void BeginDestroy() override;
+	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
+
+	virtual void NativeInitialize() override;
+	virtual void GetIndexedAssetTags(TArray<FName>& OutTags) const override;
+	virtual void NativeGatherItems() override;
+	virtual bool NativeBeginSharedEnumeration(FARFilter& OutFilter) override;
+	virtual void NativeReceiveSharedAsset(const FAssetData& InAsset) override;
+	virtual void NativeEndSharedEnumeration() override;
+	virtual void NativeDiscardSharedEnumeration() override;
+
+	// Build asset registry filter out of query properties
+	virtual FARFilter MakeFilter() const;
+	// Check whether asset passes query
+	bool PassesQuery(const FAssetData& InAsset);
+	// Check conditions registry filter can not express
+	virtual bool PassesPredicates(const FAssetData& InAsset);
+
+	// Number of assets within current result
+	int32 GetNumMatches() const { return Matches.Num(); }
+
+protected:
+	virtual bool CanAddItem(const TConfigPlaceableItem& Item) override;
+
+	FString MakeDisplayName(const FAssetData& InAsset) const;
+	void SortMatches(TArray<const FAssetData*>& InOutAssets) const;
+
+	void InvalidateQuery();
+	void PrepareQuery(const FARFilter& InFilter);
+	void EvaluateQuery();
+	// evaluate using subsystem tag index instead of registry enumeration, false if index can not answer
+	bool EvaluateQueryFromTagIndex();
+	void UpdateDerivedClasses();
+
+	void HandleAssetAdded(const FAssetData& InAsset);
+	void HandleAssetRemoved(const FAssetData& InAsset);
+	void HandleAssetUpdated(const FAssetData& InAsset);
+	void HandleAssetRenamed(const FAssetData& InAsset, const FString& InOldObjectPath);
+	// test single asset against query, returns true if result changed
+	bool UpdateMatch(const FAssetData& InAsset, bool bContentChanged);
+
+private:
+	// current query result by object path
+	TMap<FSoftObjectPath, FAssetData> Matches;
+	// compiled registry filter
+	FARCompiledFilter CompiledFilter;
+	// generated classes of blueprints derived from BlueprintParentClasses
+	TSet<FTopLevelAssetPath> DerivedClasses;
+
+	bool bQueryDirty = true;
+	bool bDerivedClassesDirty = true;
+	bool bAddingMatches = false;
+};
@@ -40,6 +40,54 @@ public:
 	UPROPERTY(Config, EditAnywhere, Category="Behavior")
 	bool bEnableChangeTrackingFeatures = false;
 
+	// Delay in seconds after the last settings edit before changes are applied and saved.
+	// Consecutive edits within this window (dragging a spinbox, typing) are coalesced into a single apply.
+	UPROPERTY(Config, EditAnywhere, Category="Behavior", meta=(ClampMin=0, UIMin=0, UIMax=5, Units="s"))
+	float SettingsApplyDelay = 0.5f;
+
+	// Maximum number of placement browser toolbar and content refreshes per second, 0 for unlimited.
+	// Refresh requests arriving faster are coalesced and applied once the interval passes.
+	UPROPERTY(Config, EditAnywhere, Category="Behavior", meta=(ClampMin=0, UIMin=0, UIMax=60, Units="Hz"))
+	float MaxWidgetRefreshRate = 10.f;
+
+	// Postpone updating categories while Place Actors panel is closed, initial content is always populated.
+	// Changes are recorded and applied once the panel is opened or brought to front.
+	UPROPERTY(Config, EditAnywhere, Category="Behavior")
+	bool bDeferUpdatesWhileHidden = true;
+
+	// Store gathered content of dynamic categories in Saved folder and restore it on editor startup.
+	// Palette is filled before initial asset scan completes, restored content is revalidated once categories are discovered.
+	UPROPERTY(Config, EditAnywhere, Category="Behavior")
+	bool bEnableContentSnapshots = true;
+
+	// Number of recently edited maps for which content of world tracking categories is kept in memory.
+	// Switching back to one of them restores content without gathering. 0 to disable.
+	UPROPERTY(Config, EditAnywhere, Category="Behavior", meta=(ClampMin=0, UIMin=0, UIMax=32))
+	int32 WorldCacheSize = 8;
+
+	// Time per editor frame spent populating dirty categories, remaining ones continue on next frames.
+	// Category shown in palette is populated first, then recently shown ones. 0 for no limit.
+	UPROPERTY(Config, EditAnywhere, Category="Behavior", meta=(ClampMin=0, UIMin=0, UIMax=100, Units="ms"))
+	float PopulateFrameBudgetMs = 6.f;
+
+	// Time a single category gather may take before it counts as over budget. 0 for no limit.
+	UPROPERTY(Config, EditAnywhere, Category="Budget", meta=(ClampMin=0, UIMin=0, UIMax=5000, Units="ms"))
+	float GatherTimeBudgetMs = 500.f;
+
+	// Time a single category update may take before it counts as over budget. 0 for no limit.
+	UPROPERTY(Config, EditAnywhere, Category="Budget", meta=(ClampMin=0, UIMin=0, UIMax=1000, Units="ms"))
+	float TickTimeBudgetMs = 20.f;
+
+	// Number of items a single category gather may produce before it counts as over budget. 0 for no limit.
+	// Items over budget are still registered, the gather only counts towards throttling.
+	UPROPERTY(Config, EditAnywhere, Category="Budget", meta=(ClampMin=0, UIMin=0))
+	int32 ItemCountBudget = 0;
+
+	// Number of consecutive over budget runs after which category is throttled. 0 to never throttle.
+	// Slow gathers pause change tracking of category, slow updates double its update interval.
+	UPROPERTY(Config, EditAnywhere, Category="Budget", meta=(ClampMin=0, UIMin=0, UIMax=10))
+	int32 ThrottleAfterViolations = 3;
+
 	// List of custom categories
 	UPROPERTY(Config, EditAnywhere, Category="Categories", meta=(TitleProperty="UniqueId", NoElementDuplicate))
 	TArray<FStaticPlacementCategoryInfo> StaticCategories;
@@ -15,6 +15,15 @@
 struct FManagedCategory;
 struct FManagedCategoryChangeTracker;
 struct FPlacementModeModuleAccess;
+struct FPaletteSearchResult;
+struct FPaletteCategoryPopulateResult;
+struct FPlaceableItem;
+struct FRestoredCategory;
+struct FCompiledBlueprintInfo;
+class FPaletteSearchIndex;
+class FPaletteWorldIndex;
+class FPaletteWorldCache;
+class FPaletteTagIndex;
 
 enum class EManagedCategoryFlags
 {
@@ -32,6 +41,12 @@ enum class EManagedCategoryFlags
 	DynamicTrait_Asset = 0x200,
 	DynamicTrait_World = 0x400,
 	DynamicTrait_Interval = 0x800,
+
+	// traits of categories reacting to editor changes (blueprint, asset, world)
+	DynamicTrait_Tracking = 0x700,
+
+	// category content is kept up to date even while placement browser is closed
+	Behavior_KeepUpdatedWhileHidden = 0x1000,
 };
 
 ENUM_CLASS_FLAGS(EManagedCategoryFlags);
@@ -47,6 +62,43 @@ enum class EManagedCategoryDirtyFlags
 
 ENUM_CLASS_FLAGS(EManagedCategoryDirtyFlags);
 
+/**
+ * Diagnostic counters of subsystem activity
+ */
+struct FEnhancedPaletteCounters
+{
+	// settings panel re-imports of PM data
+	int32 SettingsImports = 0;
+	// engine category settings applications
+	int32 EngineCategoryApplies = 0;
+	// toolbar widget refreshes
+	int32 ToolbarRefreshes = 0;
+	// content widget refreshes
+	int32 ContentRefreshes = 0;
+	// category list notifications caused by plugin itself and batched
+	int32 SuppressedNotifications = 0;
+	// content refresh requests dropped because affected categories were not shown
+	int32 SkippedContentRefreshes = 0;
+	// item registrations kept by populate because descriptor did not change
+	int32 KeptItemRegistrations = 0;
+	// registry enumerations done by shared enumeration before gather
+	int32 SharedEnumerations = 0;
+	// category filters served by shared enumeration
+	int32 SharedEnumerationClients = 0;
+	// populate passes cut short by frame budget
+	int32 PostponedPopulates = 0;
+	// gathers discarded because category was dirtied again while gathering
+	int32 CancelledGathers = 0;
+	// categories throttled for exceeding budgets
+	int32 ThrottledCategories = 0;
+	// synchronous package loads made while palette work was in progress
+	int32 SyncLoads = 0;
+	// search index queries
+	int32 Searches = 0;
+	// search index queries that took longer than 1 ms
+	int32 SlowSearches = 0;
+};
+
 
 /**
  * Core of palette customizer plugin.
@@ -80,12 +132,20 @@ public:
 	// {{{ editor tracking
 	void TrySetupPlacementModule(FName, EModuleChangeReason);
 	void OnInitialAssetsScanComplete();
+	// current editor map is about to be closed
+	void OnEditorMapClosing();
+	// new editor map is loaded and its world is ready
+	void OnEditorMapOpened();
+	// package name of current editor map, None for unsaved maps
+	static FName GetEditorMapName();
 	// }}}
 
 	// {{{ data
 	TSharedPtr<FManagedCategory> FindManagedCategory(const FName& InId) const;
 	void MarkCategoryDirty(FName UniqueId, EManagedCategoryDirtyFlags DirtyFlags = EManagedCategoryDirtyFlags::Content);
 	void MarkCategoryDirty(EManagedCategoryFlags Trait, EManagedCategoryDirtyFlags DirtyFlags = EManagedCategoryDirtyFlags::Content);
+	// dirty blueprint tracking categories interested in any of compiled blueprints, all of them if list is empty
+	void MarkCategoryDirtyForBlueprints(TConstArrayView<FCompiledBlueprintInfo> Compiled);
 	// }}}
 
 	// {{{ discovery
@@ -94,15 +154,65 @@ public:
 	void TryDiscoverFromNativeScan(TArray<TSharedPtr<FManagedCategory>>& OutCategories) const;
 	void TryDiscoverFromAssetScan(TArray<TSharedPtr<FManagedCategory>>& OutCategories) const;
 
-	void TryPopulateCategoryItems();
+	// populate dirty categories, with bDeferHidden categories that do not need to stay current are postponed
+	// returns false if frame budget was exceeded and some categories are left for next tick
+	bool TryPopulateCategoryItems(bool bDeferHidden = false);
+	// order dirty categories so that shown and recently shown ones are populated first
+	void SortPopulateQueue(TArray<FManagedCategory*>& Queue);
+	void PopulateCategory(FManagedCategory& Category);
+	// enumerate registry once for all categories about to gather that declared asset filters
+	void RunSharedAssetEnumeration(TConstArrayView<FManagedCategory*> InCategories);
+	// poll whether placement browser is shown, requests postponed populate once it appears
+	bool UpdatePaletteShown();
+	// }}}
+
+	// {{{ budgets
+	// measure category run against its budget, category is throttled after repeated violations
+	void CheckGatherBudget(FManagedCategory& Category, double Seconds, int32 NumItems);
+	void CheckTickBudget(FManagedCategory& Category, double Seconds);
+	void NotifyCategoryThrottled(const FText& Message);
+	// resume change tracking and restore update intervals of throttled categories
+	void ResumeThrottledCategories();
+	// }}}
+
+	// {{{ content snapshots
+	// register categories from last session snapshots while initial asset scan is running
+	void RestoreContentSnapshots();
+	// take over registration and items of category restored from snapshot
+	bool AdoptRestoredCategory(FManagedCategory& Category);
+	// unregister restored categories that were not discovered
+	bool DiscardRestoredCategories();
+	void SaveContentSnapshot(const FManagedCategory& Category, const TArray<TInstancedStruct<FConfigPlaceableItem>>& Items) const;
+	// }}}
+
+	// {{{ search
+	// search registered items, queries of 3+ characters match any substring, shorter ones match word starts
+	void SearchPlaceableItems(const FString& InQuery, int32 MaxResults, TArray<FPaletteSearchResult>& OutResults);
+	FPaletteSearchIndex& GetSearchIndex() const;
+	// index of actors within editor world, meant for world tracking categories
+	FPaletteWorldIndex& GetWorldIndex() const;
+	// index of assets by values of tags declared by categories
+	FPaletteTagIndex& GetTagIndex() const;
 	// }}}
 
 	// {{{ externals
 	bool CreateExternalCategory(const FStaticPlacementCategoryInfo& CreationInfo);
+	// create multiple categories with a single discovery, returns number of created categories
+	int32 CreateExternalCategories(TConstArrayView<FStaticPlacementCategoryInfo> CreationInfos);
 	bool RemoveExternalCategory(const FName& UniqueId);
 	bool AddExternalCategoryItem(const FName& UniqueId, TInstancedStruct<FConfigPlaceableItem> Item);
+	// append items to category, only appended items are registered. OutHandles can be used to remove items later
+	bool AddExternalCategoryItems(const FName& UniqueId, TConstArrayView<TInstancedStruct<FConfigPlaceableItem>> Items, TArray<FGuid>& OutHandles);
+	// remove items by handles, only removed items are unregistered. returns number of removed items
+	int32 RemoveExternalCategoryItems(const FName& UniqueId, TConstArrayView<FGuid> Handles);
+	// register and unregister items appended to or removed from external categories
+	void ApplyExternalCategoryDeltas();
+	void BroadcastCategoryPopulated(const FManagedCategory& Category, double Seconds);
 	// }}}
 
+	// make PM item from config item, null if config item is not valid
+	static TSharedPtr<FPlaceableItem> MakePlaceableItem(const FName& InCategory, const TInstancedStruct<FConfigPlaceableItem>& InConfigItem);
+
 	// called when visibility settings changed and need to be applied to PM
 	void ApplyEngineCategorySettings();
 	// called when category settings changed and need to be applied to PM
@@ -111,6 +221,8 @@ public:
 	void ApplyRecentListSettings();
 	// force settings save
 	void TrySaveSettings();
+	// are settings edits settled enough to be applied
+	bool AreSettingsEditsSettled() const;
 
 	void OnPlacementModeCategoryListChanged();
 	void OnPlaceableItemFilteringChanged();
@@ -118,15 +230,48 @@ public:
 	void OnRecentlyPlacedChanged(const TArray<FActorPlacementInfo>&);
 
 	void OnSettingsPanelSelected(); // load PM data onto settings panel
+	void ImportRecentList(); // load PM recent list onto settings panel
 	void OnSettingsPanelModified(UObject*, FPropertyChangedEvent&);
 	void OnSettingsPanelCommand(FName CommandId);
 
 	void OnCategoryBlueprintModified(class UBlueprint*, FName CategoryId);
 	void OnCategoryObjectModified(UObject*, struct FPropertyChangedEvent&, FName Category);
 
+	// count synchronous loads caused by palette work
+	void OnSyncLoadPackage(const FString& InPackageName);
+	// publish stat group values and trace counters
+	void UpdateStats() const;
+
+	/**
+	 * Scope for changes plugin makes to PM by itself.
+	 * Every category (un)registration notifies about category list change and would re-import settings panel data.
+	 * Notifications raised within the scope are batched and handled once when outermost scope ends.
+	 */
+	struct FScopedSelfMutation : FNoncopyable
+	{
+		explicit FScopedSelfMutation(UEnhancedPaletteSubsystem* InOwner);
+		~FScopedSelfMutation();
+	private:
+		UEnhancedPaletteSubsystem* Owner;
+	};
+
+	const FEnhancedPaletteCounters& GetCounters() const { return Counters; }
+	void ResetCounters() { Counters = FEnhancedPaletteCounters(); }
+
 	using FOnPlacementModuleReady = TMulticastDelegate<void(IPlacementModeModule&)>;
 	FOnPlacementModuleReady& OnPlacementModuleReady() { return OnPlacementModuleReadyPrivate; }
 
+	// Called after category items were (re)registered
+	using FOnCategoryPopulated = TMulticastDelegate<void(const FPaletteCategoryPopulateResult&)>;
+	FOnCategoryPopulated& OnCategoryPopulated() { return OnCategoryPopulatedPrivate; }
+
+	// Called at the end of each subsystem tick, parameter indicates there is no pending discovery or populate work
+	using FOnPostTick = TMulticastDelegate<void(bool)>;
+	FOnPostTick& OnPostTick() { return OnPostTickPrivate; }
+
+	// Is there no pending discovery or populate work, only listed categories are checked if any given
+	bool IsPopulateIdle(TConstArrayView<FName> InCategories = {}) const;
+
 protected:
 	// All managed categories stored here
 	TArray<TSharedPtr<FManagedCategory>> ManagedCategories;
@@ -134,6 +279,8 @@ protected:
 	TSharedPtr<FPlacementModeModuleAccess> ModuleAccessPrivate;
 
 	FOnPlacementModuleReady OnPlacementModuleReadyPrivate;
+	FOnCategoryPopulated OnCategoryPopulatedPrivate;
+	FOnPostTick OnPostTickPrivate;
 
 	FPlacementModeModuleAccess& GetModuleRef() const
 	{
@@ -143,6 +290,21 @@ protected:
 
 	TSharedPtr<FManagedCategoryChangeTracker> ExternalChangeTracker;
 
+	// Index over items registered by managed categories
+	TSharedPtr<FPaletteSearchIndex> SearchIndex;
+
+	// Index over actors within editor world
+	TSharedPtr<FPaletteWorldIndex> WorldIndex;
+
+	// Index of assets by asset registry tag values
+	TSharedPtr<FPaletteTagIndex> TagIndex;
+
+	// Content of world tracking categories for recently edited maps
+	TSharedPtr<FPaletteWorldCache> WorldCache;
+
+	// Categories registered from content snapshots and not yet adopted by discovered categories
+	TMap<FName, TSharedPtr<FRestoredCategory>> RestoredCategories;
+
 	TWeakPtr<class ISettingsSection> SettingsSectionPtr;
 
 	TWeakPtr<class SNotificationItem> NotificationItemPtr;
@@ -161,12 +323,57 @@ protected:
 	bool bRequireSettingsSave = false;
 	bool bRequireToolbarRefresh = false;
 	bool bRequireToolbarContentRefresh = false;
+	bool bRequireApplyExternalDeltas = false;
+	// next populate ignores deferral of hidden browser
+	bool bForcePopulate = false;
+	// number of waiters that need populate to ignore deferral of hidden browser until released
+	int32 ForcedPopulateHolds = 0;
+	// categories with changed content, shown content is refreshed only if one of them is active
+	TArray<FName, TInlineAllocator<4>> ContentRefreshCategories;
+
+	// time of the last widget refreshes, used to limit refresh rate
+	double LastToolbarRefreshTime = 0;
+	double LastContentRefreshTime = 0;
+
+	bool IsWidgetRefreshAllowed(double LastRefreshTime) const;
+
+	// placement browser was shown at last poll
+	bool bPaletteShown = false;
+	// time of the last placement browser visibility poll
+	double LastPaletteShownPollTime = 0;
+	// some categories were left dirty because placement browser was hidden
+	bool bPopulateDeferred = false;
+	// last time category was seen active in placement browser
+	TMap<FName, double> CategoryLastShownTime;
+
+	// palette work is in progress, synchronous loads are attributed to it
+	bool bInPaletteWork = false;
+	// category being ticked or gathered, for attribution of synchronous loads
+	FName WorkingCategory;
+
+	// depth of active self mutation scopes
+	int32 SelfMutationDepth = 0;
+	// category list changed while self mutation was in progress
+	bool bPendingCategoryListImport = false;
+
+	FEnhancedPaletteCounters Counters;
+
+	// engine category settings that were last applied to PM
+	TMap<FName, FStandardPlacementCategoryInfo> AppliedEngineCategories;
+
+	// time of the last settings panel edit, interactive ones included
+	double LastSettingsEditTime = 0;
 public:
 	inline void RequestDiscover() { bRequireDiscover = true; }
 	inline void RequestPopulate() { bRequirePopulate = true; }
+	inline void RequestForcedPopulate() { bRequirePopulate = true; bForcePopulate = true; }
+	// keep populating while placement browser is hidden until hold is released
+	inline void AddForcedPopulateHold() { ++ForcedPopulateHolds; RequestForcedPopulate(); }
+	inline void RemoveForcedPopulateHold() { ensure(ForcedPopulateHolds > 0); --ForcedPopulateHolds; }
 	inline void RequestUpdateCategoryData() { bRequireUpdateManagedCategories = true; bRequireUpdateEngineCategories = true; }
 	inline void RequestSettingsSave() { bRequireSettingsSave = true; }
 	inline void RequestRecentListSave() { bRequireApplyRecentList = true; }
 	inline void RequestToolbarRefresh() { bRequireToolbarRefresh = true; }
 	inline void RequestToolbarContentRefresh() { bRequireToolbarContentRefresh = true; }
+	inline void RequestToolbarContentRefresh(const FName& InCategory) { ContentRefreshCategories.AddUnique(InCategory); }
 };
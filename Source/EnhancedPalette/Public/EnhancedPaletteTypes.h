@@ -282,7 +282,7 @@ struct FPlacementCategoryInfo;
 /**
  * Base type for category descriptors
  */
-USTRUCT()
+USTRUCT(BlueprintType)
 struct ENHANCEDPALETTE_API FConfigPlacementCategoryInfo
 {
 	GENERATED_BODY()
@@ -322,7 +322,7 @@ public:
 /**
  * Static category details
  */
-USTRUCT()
+USTRUCT(BlueprintType)
 struct ENHANCEDPALETTE_API FStaticPlacementCategoryInfo : public FConfigPlacementCategoryInfo
 {
 	GENERATED_BODY()
@@ -330,6 +330,10 @@ struct ENHANCEDPALETTE_API FStaticPlacementCategoryInfo : public FConfigPlacemen
 	// List of elements to be displayed within category
 	UPROPERTY(EditAnywhere, Category=General, NoClear, meta=(DisplayAfter="SortOrder", ExcludeBaseStruct=true, GetDisallowedClasses="GetUnUsableStaticItems"))
 	TArray<TInstancedStruct<FConfigPlaceableItem>> Items;
+
+	// Should category content be updated while Place Actors panel is closed (e.g. when it is used by other tools)
+	UPROPERTY(EditAnywhere, Category=General)
+	bool bKeepUpdatedWhileHidden = false;
 };
 
 /**
@@ -361,3 +365,64 @@ struct TStructOpsTypeTraits<FStandardPlacementCategoryInfo>
 		WithCanEditChange = true
 	};
 };
+
+/**
+ * Result of palette item search
+ */
+USTRUCT(BlueprintType)
+struct ENHANCEDPALETTE_API FPaletteSearchResult
+{
+	GENERATED_BODY()
+
+	// Category that owns the item
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category=Search)
+	FName CategoryId;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category=Search)
+	FString NativeName;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category=Search)
+	FText DisplayName;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category=Search)
+	FString ObjectPath;
+
+	// Match quality, lower is better
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category=Search)
+	int32 Relevance = 0;
+};
+
+/**
+ * Number of actors of class within editor world
+ */
+USTRUCT(BlueprintType)
+struct ENHANCEDPALETTE_API FPaletteClassUsage
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category=World)
+	TSubclassOf<AActor> Class;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category=World)
+	int32 Count = 0;
+};
+
+/**
+ * Result of populating single palette category
+ */
+USTRUCT(BlueprintType)
+struct ENHANCEDPALETTE_API FPaletteCategoryPopulateResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category=Populate)
+	FName CategoryId;
+
+	// Number of items registered within category after populate
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category=Populate)
+	int32 NumItems = 0;
+
+	// Time spent gathering and registering items
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category=Populate, meta=(Units="s"))
+	float Seconds = 0.f;
+};
@@ -7,9 +7,6 @@
 
 #include "IconReference.generated.h"
 
-// Showcase on how to make SSearchableComboBox that only accepts strings with custom data structure
-#define WITH_MAGIC_COMBO_CAST 0
-
 /**
  * This is simple helper to prevent dependency of SlateIconReference plugin
  */
@@ -28,6 +25,12 @@ private:
 	UPROPERTY(VisibleAnywhere, Category=Icon)
 	FName StyleName;
 
+	// resolved brush cache, valid while names match and style registry did not change since it was resolved
+	mutable const FSlateBrush* CachedBrush = nullptr;
+	mutable uint32 CachedGeneration = 0;
+	mutable FName CachedStyleSetName;
+	mutable FName CachedStyleName;
+
 public:
 	FSimpleIconReference() = default;
 	FSimpleIconReference(const FString& InCode);
@@ -39,5 +42,12 @@ public:
 
 	FSlateIcon GetSlateIcon() const;
 
+	// Get resolved brush, cached until its style set is unregistered or replaced
 	const FSlateBrush* GetBrush() const;
+
+	/**
+	 * Generation of slate style registry, changes whenever style sets are registered or unregistered.
+	 * Computed at most once per frame, never zero.
+	 */
+	static uint32 GetStyleRegistryGeneration();
 };